@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+/// State passed to each benchmark. The benchmark should run its workload `iterations` times,
+/// and may record the number of items or bytes processed per iteration to report throughput
+struct State
+{
+    size_t iterations = 1;
+    size_t itemsPerIteration = 0;
+    size_t bytesPerIteration = 0;
+};
+
+using BenchmarkFunction = std::function<void(State&)>;
+
+struct Benchmark
+{
+    std::string name;
+    BenchmarkFunction function;
+};
+
+std::vector<Benchmark>& registry();
+
+struct Registration
+{
+    Registration(const char* name, BenchmarkFunction function)
+    {
+        registry().push_back({name, std::move(function)});
+    }
+};
+
+/// Prevents the compiler from optimising away a computed value
+template<typename T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+} // namespace bench
+
+#define BENCHMARK(name) \
+    static void name(bench::State& state); \
+    static bench::Registration name##_registration(#name, name); \
+    static void name(bench::State& state)
@@ -0,0 +1,78 @@
+#include "Bench.h"
+#include "LSP/JsonRpc.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+/// Builds a stream of messages resembling a typical editing session: small requests interleaved with full document syncs
+static std::string makeMessageStream(size_t messageCount)
+{
+    std::string documentText;
+    for (int i = 0; i < 200; i++)
+        documentText += "local value" + std::to_string(i) + " = game:GetService(\\\"ReplicatedStorage\\\")\\n";
+
+    std::string stream;
+    for (size_t i = 0; i < messageCount; i++)
+    {
+        std::string body;
+        if (i % 4 == 0)
+            body = R"({"jsonrpc":"2.0","method":"textDocument/didChange","params":{"textDocument":{"uri":"file:///workspace/src/init.lua","version":)" +
+                   std::to_string(i) + R"(},"contentChanges":[{"text":")" + documentText + R"("}]}})";
+        else
+            body = R"({"jsonrpc":"2.0","id":)" + std::to_string(i) +
+                   R"(,"method":"textDocument/hover","params":{"textDocument":{"uri":"file:///workspace/src/init.lua"},"position":{"line":10,"character":4}}})";
+
+        stream += "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+    }
+
+    return stream;
+}
+
+static json_rpc::MessageReader makeReader(const std::string& input, size_t& offset)
+{
+    offset = 0;
+    return json_rpc::MessageReader(
+        [&input, &offset](char* buffer, size_t size) -> size_t
+        {
+            // Emulate pipe reads, which return at most a page-sized chunk at a time
+            auto count = std::min({size, size_t(65536), input.size() - offset});
+            std::memcpy(buffer, input.data() + offset, count);
+            offset += count;
+            return count;
+        });
+}
+
+BENCHMARK(JsonRpc_ReadMessages)
+{
+    static const std::string stream = makeMessageStream(1000);
+    state.itemsPerIteration = 1000;
+    state.bytesPerIteration = stream.size();
+
+    for (size_t i = 0; i < state.iterations; i++)
+    {
+        size_t offset;
+        auto reader = makeReader(stream, offset);
+        std::string_view message;
+        while (reader.read(message))
+            bench::doNotOptimize(message.data());
+    }
+}
+
+BENCHMARK(JsonRpc_ReadAndParseMessages)
+{
+    static const std::string stream = makeMessageStream(1000);
+    state.itemsPerIteration = 1000;
+    state.bytesPerIteration = stream.size();
+
+    for (size_t i = 0; i < state.iterations; i++)
+    {
+        size_t offset;
+        auto reader = makeReader(stream, offset);
+        std::string_view message;
+        while (reader.read(message))
+        {
+            auto parsed = json_rpc::parse(message);
+            bench::doNotOptimize(parsed);
+        }
+    }
+}
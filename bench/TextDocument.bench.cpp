@@ -0,0 +1,66 @@
+#include "Bench.h"
+#include "LSP/TextDocument.hpp"
+
+/// A line containing multi-byte UTF-8 characters (including characters outside of the BMP, which are 2 UTF-16 code units)
+static std::string makeNonAsciiLine(size_t repetitions)
+{
+    std::string line;
+    for (size_t i = 0; i < repetitions; i++)
+        line += "local café = \"日本語 \xF0\x9F\x98\x80\" -- ";
+    return line;
+}
+
+static std::string makeDocument(size_t lineCount)
+{
+    std::string content;
+    for (size_t i = 0; i < lineCount; i++)
+        content += "local value" + std::to_string(i) + " = game:GetService(\"ReplicatedStorage\"):FindFirstChild(\"Value\")\n";
+    return content;
+}
+
+BENCHMARK(TextDocument_UpdateIncremental)
+{
+    static const std::string content = makeDocument(5000);
+    state.itemsPerIteration = 1000;
+
+    for (size_t i = 0; i < state.iterations; i++)
+    {
+        TextDocument document(Uri::parse("file:///bench.lua"), "luau", 0, content);
+
+        // Emulate typing: many small edits spread over the document, each followed by a position conversion
+        // which forces the line offsets to be recomputed
+        for (size_t edit = 0; edit < 1000; edit++)
+        {
+            size_t line = (edit * 37) % 5000;
+            lsp::TextDocumentContentChangeEvent change{lsp::Range{{line, 6}, {line, 6}}, "x"};
+            document.update({change}, edit + 1);
+            bench::doNotOptimize(document.convertPosition(lsp::Position{line, 10}));
+        }
+    }
+}
+
+BENCHMARK(TextDocument_ConvertPositionNonAscii)
+{
+    static const std::string line = makeNonAsciiLine(200);
+    static const TextDocument document(Uri::parse("file:///bench.lua"), "luau", 0, line + "\n" + line + "\n");
+    auto length = lspLength(line);
+    state.itemsPerIteration = 100;
+
+    for (size_t i = 0; i < state.iterations; i++)
+    {
+        for (size_t character = 0; character < length; character += length / 100)
+        {
+            auto position = document.convertPosition(lsp::Position{1, character});
+            bench::doNotOptimize(document.convertPosition(position));
+        }
+    }
+}
+
+BENCHMARK(TextDocument_LspLengthNonAscii)
+{
+    static const std::string line = makeNonAsciiLine(200);
+    state.bytesPerIteration = line.size();
+
+    for (size_t i = 0; i < state.iterations; i++)
+        bench::doNotOptimize(lspLength(line));
+}
@@ -0,0 +1,54 @@
+#include "Bench.h"
+#include "LSP/Uri.hpp"
+
+#include <iterator>
+
+static const char* uris[] = {
+    "file:///home/user/projects/game/src/shared/Modules/Utilities/init.lua",
+    "file:///c%3A/Users/user/Documents/Game%20Project/src/client/Controllers/CameraController.luau",
+    "file:///home/user/projects/game/Packages/_Index/sleitnick_knit%401.5.1/knit/KnitServer.lua",
+    "untitled:Untitled-1",
+};
+
+BENCHMARK(Uri_Parse)
+{
+    state.itemsPerIteration = std::size(uris);
+
+    for (size_t i = 0; i < state.iterations; i++)
+        for (auto uri : uris)
+            bench::doNotOptimize(Uri::parse(uri));
+}
+
+BENCHMARK(Uri_ToStringCached)
+{
+    std::vector<Uri> parsed;
+    for (auto uri : uris)
+        parsed.push_back(Uri::parse(uri));
+    state.itemsPerIteration = parsed.size();
+
+    for (size_t i = 0; i < state.iterations; i++)
+        for (const auto& uri : parsed)
+            bench::doNotOptimize(uri.toString());
+}
+
+BENCHMARK(Uri_ToStringUnencoded)
+{
+    std::vector<Uri> parsed;
+    for (auto uri : uris)
+        parsed.push_back(Uri::parse(uri));
+    state.itemsPerIteration = parsed.size();
+
+    // Encoding is skipped for the unencoded representation, which is never cached
+    for (size_t i = 0; i < state.iterations; i++)
+        for (const auto& uri : parsed)
+            bench::doNotOptimize(uri.toString(/* skipEncoding: */ true));
+}
+
+BENCHMARK(Uri_ParseAndToString)
+{
+    state.itemsPerIteration = std::size(uris);
+
+    for (size_t i = 0; i < state.iterations; i++)
+        for (auto uri : uris)
+            bench::doNotOptimize(Uri::parse(uri).toString());
+}
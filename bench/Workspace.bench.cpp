@@ -0,0 +1,110 @@
+#include "Bench.h"
+#include "LSP/Workspace.hpp"
+#include "LSP/SemanticTokens.hpp"
+
+/// Builds a Rojo-style sourcemap containing `nodeCount` nodes, nested `breadth` children per folder
+static std::string makeSourcemap(size_t nodeCount, size_t breadth)
+{
+    json root{{"name", "Game"}, {"className", "DataModel"}, {"children", json::array()}};
+
+    // Breadth-first construction, so that the tree stays balanced
+    std::vector<json*> queue{&root};
+    size_t created = 1;
+    for (size_t i = 0; created < nodeCount; i++)
+    {
+        auto& parent = *queue[i];
+        for (size_t child = 0; child < breadth && created < nodeCount; child++, created++)
+        {
+            auto name = "Node" + std::to_string(created);
+            if (created % 4 == 0)
+            {
+                parent["children"].push_back({{"name", name}, {"className", "Folder"}, {"children", json::array()}});
+            }
+            else
+            {
+                parent["children"].push_back({{"name", name}, {"className", "ModuleScript"},
+                    {"filePaths", {"src/" + std::to_string(created / 100) + "/" + name + ".lua"}}});
+            }
+        }
+
+        // Queue the folders created underneath this node to be populated
+        for (auto& child : parent["children"])
+            if (child.contains("children"))
+                queue.push_back(&child);
+    }
+
+    return root.dump();
+}
+
+static std::shared_ptr<Client> makeClient()
+{
+    return std::make_shared<Client>(
+        [](const char*, size_t)
+        {
+            return true;
+        });
+}
+
+BENCHMARK(WorkspaceFileResolver_UpdateSourceMap100k)
+{
+    static const std::string sourcemap = makeSourcemap(100000, 16);
+    state.itemsPerIteration = 100000;
+    state.bytesPerIteration = sourcemap.size();
+
+    WorkspaceFileResolver fileResolver;
+    fileResolver.rootUri = Uri::file(std::filesystem::current_path());
+
+    for (size_t i = 0; i < state.iterations; i++)
+    {
+        fileResolver.updateSourceMap(sourcemap);
+        bench::doNotOptimize(fileResolver.rootSourceNode);
+    }
+}
+
+BENCHMARK(WorkspaceFolder_IsIgnoredFile)
+{
+    static auto client = makeClient();
+    static WorkspaceFolder workspace(client, "$BENCH_WORKSPACE", Uri::file("/home/user/projects/game"), std::nullopt);
+
+    ClientConfiguration config;
+    config.ignoreGlobs = {"**/_Index/**", "**/node_modules/**", "*.spec.lua", "**/DevPackages/**", "out/**/*.lua"};
+
+    std::vector<std::filesystem::path> paths;
+    for (size_t i = 0; i < 100; i++)
+    {
+        auto name = "Module" + std::to_string(i) + (i % 10 == 0 ? ".spec.lua" : ".lua");
+        paths.emplace_back("/home/user/projects/game/src/shared/" + std::to_string(i % 7) + "/" + name);
+        paths.emplace_back("/home/user/projects/game/Packages/_Index/package" + std::to_string(i) + "/src/" + name);
+    }
+    state.itemsPerIteration = paths.size();
+
+    for (size_t i = 0; i < state.iterations; i++)
+        for (const auto& path : paths)
+            bench::doNotOptimize(workspace.isIgnoredFile(path, config));
+}
+
+BENCHMARK(SemanticTokens_PackTokens)
+{
+    std::string content;
+    for (size_t line = 0; line < 2000; line++)
+        content += "local value" + std::to_string(line) + ": number = math.floor(other.field + 1) -- comment\n";
+    TextDocument document(Uri::parse("file:///bench.lua"), "luau", 0, content);
+
+    // Tokens are generated in reverse order, so that sorting has to do some work
+    std::vector<SemanticToken> tokens;
+    for (unsigned int line = 2000; line-- > 0;)
+    {
+        tokens.push_back(SemanticToken{{line, 6}, {line, 16}, lsp::SemanticTokenTypes::Variable, lsp::SemanticTokenModifiers::Declaration});
+        tokens.push_back(SemanticToken{{line, 18}, {line, 24}, lsp::SemanticTokenTypes::Type, lsp::SemanticTokenModifiers::None});
+        tokens.push_back(SemanticToken{{line, 27}, {line, 31}, lsp::SemanticTokenTypes::Namespace, lsp::SemanticTokenModifiers::DefaultLibrary});
+        tokens.push_back(SemanticToken{{line, 32}, {line, 37}, lsp::SemanticTokenTypes::Function, lsp::SemanticTokenModifiers::DefaultLibrary});
+        tokens.push_back(SemanticToken{{line, 44}, {line, 49}, lsp::SemanticTokenTypes::Property, lsp::SemanticTokenModifiers::None});
+    }
+    state.itemsPerIteration = tokens.size();
+
+    for (size_t i = 0; i < state.iterations; i++)
+    {
+        auto copy = tokens;
+        bench::doNotOptimize(packTokens(&document, copy));
+    }
+}
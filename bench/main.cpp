@@ -0,0 +1,130 @@
+#include "Bench.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "nlohmann/json.hpp"
+
+namespace bench
+{
+std::vector<Benchmark>& registry()
+{
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+} // namespace bench
+
+struct BenchmarkResult
+{
+    std::string name;
+    size_t iterations;
+    double nsPerIteration;
+    double itemsPerSecond;
+    double bytesPerSecond;
+};
+
+static void displayHelp(const char* argv0)
+{
+    printf("Usage: %s [options] [filter]\n", argv0);
+    printf("Runs all benchmarks whose name contains [filter]\n");
+    printf("\n");
+    printf("Options:\n");
+    printf("  --json: output the results as JSON, for tracking regressions across releases\n");
+    printf("  --min-time=SECONDS: the minimum time to run each benchmark for (default 0.5)\n");
+}
+
+static BenchmarkResult runBenchmark(const bench::Benchmark& benchmark, std::chrono::duration<double> minimumDuration)
+{
+    // Increase the iteration count until a benchmark has run for long enough to give a stable measurement
+    bench::State state;
+    std::chrono::duration<double> elapsed{0};
+    while (true)
+    {
+        auto start = std::chrono::steady_clock::now();
+        benchmark.function(state);
+        elapsed = std::chrono::steady_clock::now() - start;
+
+        if (elapsed >= minimumDuration || state.iterations >= (size_t(1) << 30))
+            break;
+        state.iterations *= 2;
+    }
+
+    double seconds = elapsed.count();
+    return BenchmarkResult{
+        benchmark.name,
+        state.iterations,
+        seconds * 1e9 / double(state.iterations),
+        double(state.itemsPerIteration * state.iterations) / seconds,
+        double(state.bytesPerIteration * state.iterations) / seconds,
+    };
+}
+
+int main(int argc, char** argv)
+{
+    const char* filter = nullptr;
+    bool outputJson = false;
+    std::chrono::duration<double> minimumDuration{0.5};
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0)
+        {
+            displayHelp(argv[0]);
+            return 0;
+        }
+        else if (strcmp(argv[i], "--json") == 0)
+        {
+            outputJson = true;
+        }
+        else if (strncmp(argv[i], "--min-time=", 11) == 0)
+        {
+            minimumDuration = std::chrono::duration<double>(std::stod(argv[i] + 11));
+        }
+        else if (argv[i][0] == '-')
+        {
+            fprintf(stderr, "Unknown option '%s'\n", argv[i]);
+            return 1;
+        }
+        else
+        {
+            filter = argv[i];
+        }
+    }
+
+    nlohmann::json results = nlohmann::json::array();
+
+    for (const auto& benchmark : bench::registry())
+    {
+        if (filter && benchmark.name.find(filter) == std::string::npos)
+            continue;
+
+        auto result = runBenchmark(benchmark, minimumDuration);
+
+        if (outputJson)
+        {
+            results.push_back({
+                {"name", result.name},
+                {"iterations", result.iterations},
+                {"nsPerIteration", result.nsPerIteration},
+                {"itemsPerSecond", result.itemsPerSecond},
+                {"bytesPerSecond", result.bytesPerSecond},
+            });
+            continue;
+        }
+
+        printf("%-40s %12zu iterations %14.1f ns/iter", result.name.c_str(), result.iterations, result.nsPerIteration);
+        if (result.itemsPerSecond > 0)
+            printf(" %14.0f items/s", result.itemsPerSecond);
+        if (result.bytesPerSecond > 0)
+            printf(" %10.1f MB/s", result.bytesPerSecond / (1024.0 * 1024.0));
+        printf("\n");
+        fflush(stdout);
+    }
+
+    if (outputJson)
+        printf("%s\n", nlohmann::json{{"benchmarks", results}}.dump(4).c_str());
+
+    return 0;
+}
@@ -326,6 +326,11 @@ export async function activate(context: vscode.ExtensionContext) {
     }
   }
 
+  // Persist caches (e.g. the workspace require graph) between sessions to speed up startup
+  if (context.storageUri) {
+    args.push(`--cache-dir=${context.storageUri.fsPath}`);
+  }
+
   // Handle FFlags
   const fflags: FFlags = {};
   const fflagsConfig = vscode.workspace.getConfiguration("luau-lsp.fflags");
@@ -11,8 +11,9 @@
 #include "Luau/Transpiler.h"
 #include "LSP/LuauExt.hpp"
 #include "LSP/WorkspaceFileResolver.hpp"
+#include "LSP/FileInventory.hpp"
 #include "LSP/Utils.hpp"
-#include "glob/glob.hpp"
+#include "LSP/GlobMatcher.hpp"
 #include <iostream>
 #include <filesystem>
 #include <vector>
@@ -52,7 +53,7 @@ static void report(ReportFormat format, const char* name, const Luau::Location&
     }
 }
 
-static bool isIgnoredFile(const std::filesystem::path& rootUriPath, const std::filesystem::path& path, std::vector<std::string>& ignoreGlobPatterns)
+static bool isIgnoredFile(const std::filesystem::path& rootUriPath, const std::filesystem::path& path, const GlobMatcher& ignoreGlobs)
 {
     auto relativePath = path.lexically_relative(rootUriPath).generic_string(); // HACK: we convert to generic string so we get '/' separators
 
@@ -60,15 +61,11 @@ static bool isIgnoredFile(const std::filesystem::path& rootUriPath, const std::f
     if (relativePath.empty())
         relativePath = path.generic_string();
 
-    for (auto& pattern : ignoreGlobPatterns)
-        if (glob::fnmatch_case(relativePath, pattern))
-            return true;
-
-    return false;
+    return ignoreGlobs.matches(relativePath);
 }
 
 static bool reportError(
-    const Luau::Frontend& frontend, ReportFormat format, const Luau::TypeError& error, std::vector<std::string>& ignoreGlobPatterns)
+    const Luau::Frontend& frontend, ReportFormat format, const Luau::TypeError& error, const GlobMatcher& ignoreGlobs)
 {
     auto* fileResolver = static_cast<WorkspaceFileResolver*>(frontend.fileResolver);
     std::filesystem::path rootUriPath = fileResolver->rootUri.fsPath();
@@ -81,7 +78,7 @@ static bool reportError(
 
     std::string humanReadableName = fileResolver->getHumanReadableModuleName(errorFriendlyName);
 
-    if (isIgnoredFile(rootUriPath, *path, ignoreGlobPatterns))
+    if (isIgnoredFile(rootUriPath, *path, ignoreGlobs))
         return false;
 
     if (const auto* syntaxError = Luau::get_if<Luau::SyntaxError>(&error.data))
@@ -99,7 +96,7 @@ static void reportWarning(ReportFormat format, const char* name, const Luau::Lin
 }
 
 static bool analyzeFile(
-    Luau::Frontend& frontend, const std::filesystem::path& path, ReportFormat format, bool annotate, std::vector<std::string>& ignoreGlobPatterns)
+    Luau::Frontend& frontend, const std::filesystem::path& path, ReportFormat format, bool annotate, const GlobMatcher& ignoreGlobs)
 {
     Luau::CheckResult cr;
     Luau::ModuleName name = path.generic_string();
@@ -115,7 +112,7 @@ static bool analyzeFile(
 
     unsigned int reportedErrors = 0;
     for (auto& error : cr.errors)
-        reportedErrors += reportError(frontend, format, error, ignoreGlobPatterns);
+        reportedErrors += reportError(frontend, format, error, ignoreGlobs);
 
     // For the human readable module name, we use a relative version
     auto errorFriendlyName = std::filesystem::proximate(path).generic_string();
@@ -198,17 +195,10 @@ int startAnalyze(int argc, char** argv)
 
             if (std::filesystem::is_directory(path))
             {
-                for (std::filesystem::recursive_directory_iterator next(path), end; next != end; ++next)
-                {
-                    if (next->is_regular_file() && next->path().has_extension())
-                    {
-                        auto ext = next->path().extension();
-                        if (ext == ".lua" || ext == ".luau")
-                        {
-                            files.push_back(next->path());
-                        }
-                    }
-                }
+                FileInventory inventory(path);
+                inventory.build();
+                for (const auto& entry : inventory.entries())
+                    files.push_back(entry.path);
             }
             else
             {
@@ -255,14 +245,14 @@ int startAnalyze(int argc, char** argv)
     {
         if (std::optional<std::string> contents = readFile(*settingsPath))
         {
-            client.configuration = dottedToClientConfiguration(contents.value());
+            client.configuration = makeConfigurationSnapshot(dottedToClientConfiguration(contents.value()));
 
             // Process any fflags
-            registerFastFlags(client.configuration.fflags.override);
-            if (!client.configuration.fflags.enableByDefault)
+            registerFastFlags(client.configuration->fflags.override);
+            if (!client.configuration->fflags.enableByDefault)
                 std::cerr << "warning: `luau-lsp.fflags.enableByDefault` is not respected in CLI Analyze mode. Please instead use the CLI option "
                              "`--no-flags-enabled` to configure this.\n";
-            if (client.configuration.fflags.sync)
+            if (client.configuration->fflags.sync)
                 std::cerr << "warning: `luau-lsp.fflags.sync` is not supported in CLI Analyze mode. Instead, all FFlags are enabled by default. "
                              "Please manually configure necessary FFlags\n";
         }
@@ -352,10 +342,11 @@ int startAnalyze(int argc, char** argv)
     Luau::freeze(frontend.globals.globalTypes);
     Luau::freeze(frontend.globalsForAutocomplete.globalTypes);
 
+    GlobMatcher ignoreGlobs(ignoreGlobPatterns);
     int failed = 0;
 
     for (const std::filesystem::path& path : files)
-        failed += !analyzeFile(frontend, path, format, annotate, ignoreGlobPatterns);
+        failed += !analyzeFile(frontend, path, format, annotate, ignoreGlobs);
 
     if (!client.diagnostics.empty())
     {
@@ -0,0 +1,55 @@
+#include "LSP/CallGraphIndex.hpp"
+
+void CallGraphIndex::update(const std::string& moduleName, std::vector<Caller> callers)
+{
+    auto& moduleCalls = modules[moduleName];
+    moduleCalls.callers = std::move(callers);
+    moduleCalls.callersByDefinitionModule.clear();
+
+    for (size_t i = 0; i < moduleCalls.callers.size(); ++i)
+    {
+        for (const auto& call : moduleCalls.callers[i].calls)
+        {
+            auto& callerIndices = moduleCalls.callersByDefinitionModule[call.definitionModuleName];
+            if (callerIndices.empty() || callerIndices.back() != i)
+                callerIndices.push_back(i);
+        }
+    }
+}
+
+void CallGraphIndex::remove(const std::string& moduleName)
+{
+    modules.erase(moduleName);
+}
+
+void CallGraphIndex::clear()
+{
+    modules.clear();
+}
+
+std::vector<std::pair<const CallGraphIndex::Caller*, std::vector<Luau::Location>>> CallGraphIndex::findIncomingCalls(
+    const std::string& moduleName, const std::string& definitionModuleName, const Luau::Location& definitionLocation) const
+{
+    auto moduleCalls = modules.find(moduleName);
+    if (moduleCalls == modules.end())
+        return {};
+
+    auto callerIndices = moduleCalls->second.callersByDefinitionModule.find(definitionModuleName);
+    if (callerIndices == moduleCalls->second.callersByDefinitionModule.end())
+        return {};
+
+    std::vector<std::pair<const Caller*, std::vector<Luau::Location>>> result;
+    for (auto index : callerIndices->second)
+    {
+        const auto& caller = moduleCalls->second.callers[index];
+
+        std::vector<Luau::Location> locations;
+        for (const auto& call : caller.calls)
+            if (call.definitionModuleName == definitionModuleName && call.definitionLocation == definitionLocation)
+                locations.push_back(call.location);
+
+        if (!locations.empty())
+            result.emplace_back(&caller, std::move(locations));
+    }
+    return result;
+}
@@ -3,6 +3,11 @@
 #include <iostream>
 #include <optional>
 
+Client::Client(json_rpc::MessageWriter::WriteFunction writeFn)
+    : writer(std::move(writeFn))
+{
+}
+
 void Client::sendRequest(
     const id_type& id, const std::string& method, const std::optional<json>& params, const std::optional<ResponseHandler>& handler)
 {
@@ -15,7 +20,10 @@ void Client::sendRequest(
 
     // Register a response handler
     if (handler)
+    {
+        std::unique_lock lock(responseHandlerMutex);
         responseHandler.emplace(id, *handler);
+    }
 
     sendRawMessage(msg);
 }
@@ -85,21 +93,42 @@ void Client::registerCapability(const std::string& registrationId, const std::st
     sendRequest(nextRequestId++, "client/registerCapability", lsp::RegistrationParams{{registration}});
 }
 
-const ClientConfiguration Client::getConfiguration(const lsp::DocumentUri& uri)
+ClientConfigurationPtr Client::getConfiguration(const lsp::DocumentUri& uri)
 {
     auto key = uri.toString();
-    if (configStore.find(key) != configStore.end())
+    std::lock_guard guard(configMutex);
+    if (auto it = configStore.find(key); it != configStore.end())
     {
-        return configStore.at(key);
+        return it->second;
     }
     return globalConfig;
 }
 
+ClientConfigurationPtr Client::getGlobalConfiguration()
+{
+    std::lock_guard guard(configMutex);
+    return globalConfig;
+}
+
+void Client::setGlobalConfiguration(const ClientConfiguration& config)
+{
+    auto snapshot = makeConfigurationSnapshot(config);
+    std::lock_guard guard(configMutex);
+    globalConfig = std::move(snapshot);
+}
+
 void Client::removeConfiguration(const lsp::DocumentUri& uri)
 {
+    std::lock_guard guard(configMutex);
     configStore.erase(uri.toString());
 }
 
+void Client::clearConfiguration()
+{
+    std::lock_guard guard(configMutex);
+    configStore.clear();
+}
+
 void Client::requestConfiguration(const std::vector<lsp::DocumentUri>& uris)
 {
     std::vector<lsp::ConfigurationItem> items{};
@@ -126,15 +155,17 @@ void Client::requestConfiguration(const std::vector<lsp::DocumentUri>& uris)
                 while (workspaceIt != uris.end() && configIt != configs.end())
                 {
                     auto uri = *workspaceIt;
-                    ClientConfiguration config;
-                    if (!configIt->is_null())
-                        config = *configIt;
+                    ClientConfigurationPtr config =
+                        makeConfigurationSnapshot(configIt->is_null() ? ClientConfiguration{} : configIt->get<ClientConfiguration>());
 
-                    ClientConfiguration* oldConfig = nullptr;
-                    if (auto it = configStore.find(uri.toString()); it != configStore.end())
-                        oldConfig = &it->second;
+                    ClientConfigurationPtr oldConfig = nullptr;
+                    {
+                        std::lock_guard guard(configMutex);
+                        if (auto it = configStore.find(uri.toString()); it != configStore.end())
+                            oldConfig = it->second;
+                        configStore.insert_or_assign(uri.toString(), config);
+                    }
 
-                    configStore.insert_or_assign(uri.toString(), config);
                     sendLogMessage(lsp::MessageType::Info, "loaded configuration for " + uri.toString());
                     if (configChangedCallback)
                         configChangedCallback(uri, config, oldConfig);
@@ -161,7 +192,14 @@ void Client::applyEdit(const lsp::ApplyWorkspaceEditParams& params, const std::o
 
 void Client::publishDiagnostics(const lsp::PublishDiagnosticsParams& params)
 {
-    sendNotification("textDocument/publishDiagnostics", params);
+    json msg{
+        {"jsonrpc", "2.0"},
+        {"method", "textDocument/publishDiagnostics"},
+        {"params", params},
+    };
+
+    // Only the latest diagnostics for a document are relevant, so any older diagnostics still waiting to be written can be dropped
+    sendRawMessage(msg, "textDocument/publishDiagnostics:" + params.uri.toString());
 }
 
 void Client::refreshWorkspaceDiagnostics()
@@ -183,9 +221,9 @@ void Client::setTrace(const lsp::SetTraceParams& params)
     traceMode = params.value;
 }
 
-bool Client::readRawMessage(std::string& output)
+bool Client::readRawMessage(std::string_view& output)
 {
-    return json_rpc::readRawMessage(std::cin, output);
+    return reader.read(output);
 }
 
 void Client::handleResponse(const JsonRpcMessage& message)
@@ -197,16 +235,23 @@ void Client::handleResponse(const JsonRpcMessage& message)
     {
         if (message.id)
         {
-            // Check if a response handler was registered for this response
-            if (responseHandler.find(*message.id) == responseHandler.end())
-                return;
+            ResponseHandler handler;
+
+            {
+                std::unique_lock lock(responseHandlerMutex);
+
+                // Check if a response handler was registered for this response
+                auto it = responseHandler.find(*message.id);
+                if (it == responseHandler.end())
+                    return;
+
+                // Deregister the handler
+                handler = std::move(it->second);
+                responseHandler.erase(it);
+            }
 
             // Call the handler on the message
-            auto handler = responseHandler.at(*message.id);
             handler(message);
-
-            // Deregister the handler
-            responseHandler.erase(*message.id);
         }
     }
     catch (const std::exception& e)
@@ -215,7 +260,12 @@ void Client::handleResponse(const JsonRpcMessage& message)
     }
 }
 
-void Client::sendRawMessage(const json& message)
+void Client::flush()
+{
+    writer.flush();
+}
+
+void Client::sendRawMessage(const json& message, const std::optional<std::string>& supersedeKey)
 {
-    json_rpc::sendRawMessage(std::cout, message);
+    writer.write(message.dump(), supersedeKey);
 }
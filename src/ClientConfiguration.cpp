@@ -0,0 +1,16 @@
+#include "LSP/ClientConfiguration.hpp"
+
+ClientConfigurationPtr makeConfigurationSnapshot(ClientConfiguration configuration)
+{
+    configuration.ignoreGlobMatcher = std::make_shared<const GlobMatcher>(configuration.ignoreGlobs);
+
+    configuration.canonicalDefinitionFiles.clear();
+    for (const auto& file : configuration.types.definitionFiles)
+    {
+        std::error_code ec;
+        auto canonicalName = std::filesystem::weakly_canonical(file, ec);
+        configuration.canonicalDefinitionFiles.insert((ec.value() != 0 ? file : canonicalName).generic_string());
+    }
+
+    return std::make_shared<const ClientConfiguration>(std::move(configuration));
+}
@@ -0,0 +1,19 @@
+#include "LSP/DefinitionsSnapshot.hpp"
+#include "LSP/Utils.hpp"
+
+DefinitionsSnapshot DefinitionsSnapshot::load(const std::vector<std::filesystem::path>& paths)
+{
+    DefinitionsSnapshot snapshot;
+    snapshot.hash = hashString("definitions");
+    snapshot.files.reserve(paths.size());
+
+    for (const auto& path : paths)
+    {
+        auto contents = readFile(path);
+        if (contents)
+            snapshot.hash = hashString(*contents, snapshot.hash);
+        snapshot.files.push_back(File{path, std::move(contents)});
+    }
+
+    return snapshot;
+}
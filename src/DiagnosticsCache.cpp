@@ -0,0 +1,70 @@
+#include "LSP/DiagnosticsCache.hpp"
+
+#include <iomanip>
+#include <sstream>
+
+#include "LSP/Utils.hpp"
+
+/// Bumped whenever the format of the cache file, or how diagnostics are computed, changes, so that old cache files are discarded
+static constexpr int CacheVersion = 1;
+
+DiagnosticsCache DiagnosticsCache::load(const std::filesystem::path& path)
+{
+    DiagnosticsCache cache;
+
+    auto contents = readFile(path);
+    if (!contents)
+        return cache;
+
+    try
+    {
+        auto data = json::parse(*contents);
+        if (data.at("version").get<int>() != CacheVersion)
+            return cache;
+
+        for (auto& [uri, file] : data.at("files").items())
+            cache.entries.emplace(uri, Entry{file.at("key").get<uint64_t>(), std::move(file.at("diagnostics"))});
+    }
+    catch (const std::exception&)
+    {
+        // The cache is malformed, so start afresh
+        cache.entries.clear();
+    }
+
+    return cache;
+}
+
+bool DiagnosticsCache::save(const std::filesystem::path& path)
+{
+    json files = json::object();
+    for (const auto& [uri, entry] : entries)
+        files[uri] = {{"key", entry.key}, {"diagnostics", entry.diagnostics}};
+    json data = {{"version", CacheVersion}, {"files", std::move(files)}};
+
+    if (!writeFileAtomically(path, data.dump()))
+        return false;
+
+    modified = false;
+    return true;
+}
+
+std::filesystem::path DiagnosticsCache::pathForWorkspace(const std::filesystem::path& cacheDirectory, const std::string& workspaceUri)
+{
+    std::stringstream name;
+    name << "diagnostics-" << std::hex << std::setw(16) << std::setfill('0') << hashString(workspaceUri) << ".json";
+    return cacheDirectory / name.str();
+}
+
+const json* DiagnosticsCache::find(const std::string& uri, uint64_t key) const
+{
+    auto it = entries.find(uri);
+    if (it == entries.end() || it->second.key != key)
+        return nullptr;
+    return &it->second.diagnostics;
+}
+
+void DiagnosticsCache::insert(const std::string& uri, uint64_t key, json diagnostics)
+{
+    entries.insert_or_assign(uri, Entry{key, std::move(diagnostics)});
+    modified = true;
+}
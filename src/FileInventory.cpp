@@ -0,0 +1,127 @@
+#include "LSP/FileInventory.hpp"
+
+#include "Luau/StringUtils.h"
+
+FileInventory::FileInventory(std::filesystem::path root)
+    : root(std::move(root))
+{
+}
+
+bool FileInventory::isSourceFile(const std::filesystem::path& path)
+{
+    auto ext = path.extension();
+    return ext == ".lua" || ext == ".luau";
+}
+
+void FileInventory::build(DirectoryFilter skipDirectory)
+{
+    this->skipDirectory = std::move(skipDirectory);
+    files.clear();
+    indices.clear();
+    built = true;
+    addDirectory(root);
+}
+
+void FileInventory::add(const std::filesystem::path& path)
+{
+    std::error_code ec;
+    if (std::filesystem::is_directory(path, ec))
+    {
+        if (!isSkipped(path))
+            addDirectory(path);
+    }
+    else if (isSourceFile(path) && !isSkipped(path.parent_path()))
+    {
+        insert(path);
+    }
+}
+
+bool FileInventory::isSkipped(const std::filesystem::path& directory) const
+{
+    if (!skipDirectory)
+        return false;
+
+    // The directory is skipped if it, or any of its ancestors below the root, would not have been walked
+    auto relativePath = directory.lexically_relative(root);
+    if (relativePath.empty() || relativePath == "." || *relativePath.begin() == "..")
+        return false;
+
+    auto ancestor = root;
+    for (const auto& part : relativePath)
+    {
+        ancestor /= part;
+        if (skipDirectory(ancestor))
+            return true;
+    }
+    return false;
+}
+
+void FileInventory::addDirectory(const std::filesystem::path& directory)
+{
+    std::error_code ec;
+    for (std::filesystem::recursive_directory_iterator next(directory, ec), end; next != end; next.increment(ec))
+    {
+        if (ec)
+            break;
+
+        if (next->is_directory())
+        {
+            if (skipDirectory && skipDirectory(next->path()))
+                next.disable_recursion_pending();
+        }
+        else if (next->is_regular_file() && isSourceFile(next->path()))
+        {
+            insert(next->path());
+        }
+    }
+}
+
+void FileInventory::insert(const std::filesystem::path& path)
+{
+    if (indices.emplace(path.generic_string(), files.size()).second)
+        files.push_back(Entry{path});
+}
+
+void FileInventory::remove(const std::filesystem::path& path)
+{
+    auto removeAt = [this](size_t index)
+    {
+        indices.erase(files[index].path.generic_string());
+        if (index != files.size() - 1)
+        {
+            files[index] = std::move(files.back());
+            indices[files[index].path.generic_string()] = index;
+        }
+        files.pop_back();
+    };
+
+    auto key = path.generic_string();
+    if (auto it = indices.find(key); it != indices.end())
+    {
+        removeAt(it->second);
+        return;
+    }
+
+    // The path may have been a directory
+    auto prefix = key + "/";
+    for (size_t i = files.size(); i > 0; i--)
+        if (Luau::startsWith(files[i - 1].path.generic_string(), prefix))
+            removeAt(i - 1);
+}
+
+const std::vector<FileInventory::Entry>& FileInventory::entries(const std::string& key, const Classifier& classify)
+{
+    bool reclassify = key != classificationKey;
+    classificationKey = key;
+
+    for (auto& entry : files)
+    {
+        if (!entry.classified || reclassify)
+        {
+            entry.classification = classify(entry.path);
+            entry.classified = true;
+        }
+    }
+
+    return files;
+}
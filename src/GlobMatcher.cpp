@@ -0,0 +1,64 @@
+#include "LSP/GlobMatcher.hpp"
+
+#include "glob/glob.hpp"
+
+static std::optional<std::regex> compilePatterns(const std::vector<std::string>& patterns)
+{
+    if (patterns.empty())
+        return std::nullopt;
+
+    std::string combined;
+    for (const auto& pattern : patterns)
+    {
+        if (!combined.empty())
+            combined += "|";
+        combined += glob::translate(pattern);
+    }
+
+    return std::regex(combined, std::regex::ECMAScript | std::regex::optimize);
+}
+
+GlobMatcher::GlobMatcher(std::vector<std::string> patterns)
+    : patterns(std::move(patterns))
+{
+    regex = compilePatterns(this->patterns);
+
+    std::vector<std::string> directoryPatterns;
+    for (const auto& pattern : this->patterns)
+    {
+        if (auto lastNonStar = pattern.find_last_not_of('*'); lastNonStar != pattern.size() - 1)
+            directoryPatterns.push_back(pattern.substr(0, lastNonStar + 1));
+    }
+    directoryRegex = compilePatterns(directoryPatterns);
+}
+
+bool GlobMatcher::matches(const std::string& relativePath) const
+{
+    if (!regex)
+        return false;
+
+    std::unique_lock lock(cacheMutex);
+    if (auto it = cache.find(relativePath); it != cache.end())
+        return it->second;
+    lock.unlock();
+
+    bool result = std::regex_match(relativePath, *regex);
+
+    lock.lock();
+    cache.emplace(relativePath, result);
+    return result;
+}
+
+bool GlobMatcher::matchesEntireDirectory(const std::string& relativeDirectory) const
+{
+    if (!directoryRegex)
+        return false;
+
+    // If the pattern up to its trailing `*` matches the directory or any of its ancestors, the `*` matches anything within it
+    auto path = relativeDirectory + "/";
+    for (auto separator = path.find('/'); separator != std::string::npos; separator = path.find('/', separator + 1))
+        if (std::regex_match(path.begin(), path.begin() + separator + 1, *directoryRegex))
+            return true;
+
+    return false;
+}
@@ -3,6 +3,17 @@
 #include <string>
 #include <exception>
 #include <variant>
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#include <cerrno>
+#endif
 
 #include "nlohmann/json.hpp"
 #include "Luau/StringUtils.h"
@@ -12,9 +23,9 @@ using json = nlohmann::json;
 
 namespace json_rpc
 {
-JsonRpcMessage parse(const std::string& jsonString)
+JsonRpcMessage parse(std::string_view jsonString)
 {
-    auto j = json::parse(jsonString);
+    auto j = json::parse(jsonString.begin(), jsonString.end());
     std::string jsonrpc_version = j.at("jsonrpc").get<std::string>();
 
     if (jsonrpc_version != "2.0")
@@ -40,14 +51,15 @@ JsonRpcMessage parse(const std::string& jsonString)
         j.at("method").get_to(method);
 
     // Parse params (if present)
+    // We move the params out of the parsed document, as they can be large (e.g., full text document changes)
     std::optional<json> params;
-    if (j.contains("params"))
-        params = j.at("params");
+    if (auto it = j.find("params"); it != j.end())
+        params = std::move(*it);
 
     // Parse result if present
     std::optional<json> result;
-    if (j.contains("result"))
-        result = j.at("result");
+    if (auto it = j.find("result"); it != j.end())
+        result = std::move(*it);
 
     // Parse error if present
     std::optional<JsonRpcException> error;
@@ -69,59 +81,254 @@ JsonRpcMessage parse(const std::string& jsonString)
     return JsonRpcMessage{id, method, params, result, error};
 }
 
-/// Reads a JSON-RPC message from input
-bool readRawMessage(std::istream& input, std::string& output)
+MessageReader::MessageReader(ReadFunction readFn, size_t initialCapacity)
+    : readFn(std::move(readFn))
+    , initialCapacity(initialCapacity)
+{
+}
+
+MessageReader MessageReader::fromFileDescriptor(int fd)
+{
+    return MessageReader(
+        [fd](char* buffer, size_t size) -> size_t
+        {
+            while (true)
+            {
+#ifdef _WIN32
+                auto bytesRead = _read(fd, buffer, static_cast<unsigned int>(std::min(size, size_t(INT_MAX))));
+#else
+                auto bytesRead = ::read(fd, buffer, size);
+                if (bytesRead < 0 && errno == EINTR)
+                    continue;
+#endif
+                return bytesRead > 0 ? size_t(bytesRead) : 0;
+            }
+        });
+}
+
+bool MessageReader::fill(size_t required)
+{
+    // Move the unconsumed data to the front of the buffer to make space
+    if (start > 0)
+    {
+        std::memmove(buffer.data(), buffer.data() + start, end - start);
+        end -= start;
+        start = 0;
+    }
+
+    if (buffer.size() < std::max(required, initialCapacity))
+        buffer.resize(std::max({required, initialCapacity, buffer.size() * 2}));
+
+    // Ensure that there is always some space available to read into
+    if (end == buffer.size())
+        buffer.resize(buffer.size() * 2);
+
+    auto bytesRead = readFn(buffer.data() + end, buffer.size() - end);
+    end += bytesRead;
+    return bytesRead > 0;
+}
+
+static bool equalsIgnoreCase(std::string_view a, std::string_view b)
 {
-    unsigned int contentLength = 0;
-    std::string line = "";
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(),
+                                       [](char x, char y)
+                                       {
+                                           return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+                                       });
+}
 
-    // Read the headers
+bool MessageReader::read(std::string_view& output)
+{
     while (true)
     {
-        if (!input)
-            return false;
-        std::getline(input, line);
+        // Parse the headers in place. If they are incomplete, we read in more data and parse them again
+        std::optional<size_t> contentLength = std::nullopt;
+        std::optional<size_t> bodyStart = std::nullopt;
 
-        if (Luau::startsWith(line, "Content-Length: "))
+        size_t lineStart = start;
+        while (lineStart < end)
         {
-            if (contentLength != 0)
+            auto newline = static_cast<const char*>(std::memchr(buffer.data() + lineStart, '\n', end - lineStart));
+            if (!newline)
+                break;
+
+            auto lineEnd = size_t(newline - buffer.data());
+            std::string_view line{buffer.data() + lineStart, lineEnd - lineStart};
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+            lineStart = lineEnd + 1;
+
+            // An empty line ends the header block
+            if (line.empty())
+            {
+                bodyStart = lineStart;
+                break;
+            }
+
+            auto colon = line.find(':');
+            if (colon == std::string_view::npos || !equalsIgnoreCase(line.substr(0, colon), "Content-Length"))
+                continue;
+
+            auto value = line.substr(colon + 1);
+            while (!value.empty() && (value.front() == ' ' || value.front() == '\t'))
+                value.remove_prefix(1);
+
+            size_t length = 0;
+            auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), length);
+            if (ec == std::errc{})
             {
-                std::cerr << "Duplicate content-length header found. Discarding old value";
+                if (contentLength)
+                    std::cerr << "Duplicate content-length header found. Discarding old value\n";
+                contentLength = length;
             }
-            std::string len = line.substr(16);
-            trim_end(len);
-            contentLength = std::stoi(len);
+        }
+
+        if (!bodyStart)
+        {
+            if (!fill(end - start + 1))
+                return false;
             continue;
         }
 
-        // Trim line and check if its empty (i.e., we have ended the header block)
-        trim_end(line);
-        if (line.empty())
-            break;
+        if (!contentLength || *contentLength == 0)
+        {
+            // Discard the malformed header block and try the next message
+            std::cerr << "JSON-RPC message received with no Content-Length header. Discarding\n";
+            start = *bodyStart;
+            continue;
+        }
+
+        // Read in the rest of the body
+        size_t messageSize = *bodyStart - start + *contentLength;
+        while (end - start < messageSize)
+        {
+            auto headerSize = *bodyStart - start;
+            if (!fill(messageSize))
+                return false;
+            bodyStart = start + headerSize;
+        }
+
+        output = std::string_view{buffer.data() + *bodyStart, *contentLength};
+        start = *bodyStart + *contentLength;
+        return true;
     }
+}
+
+MessageWriter::MessageWriter(WriteFunction writeFn)
+    : writeFn(std::move(writeFn))
+{
+    thread = std::thread(&MessageWriter::writerLoop, this);
+}
 
-    // Check if no Content-Length found
-    if (contentLength == 0)
+MessageWriter::~MessageWriter()
+{
     {
-        return false;
+        std::unique_lock lock(mutex);
+        stopping = true;
     }
+    condition.notify_one();
+    thread.join();
+}
 
-    // TODO: check if contentlength is too large?
+MessageWriter::WriteFunction MessageWriter::fileDescriptorWriter(int fd)
+{
+    return [fd](const char* data, size_t size) -> bool
+    {
+        while (size > 0)
+        {
+#ifdef _WIN32
+            auto bytesWritten = _write(fd, data, static_cast<unsigned int>(std::min(size, size_t(INT_MAX))));
+#else
+            auto bytesWritten = ::write(fd, data, size);
+            if (bytesWritten < 0 && errno == EINTR)
+                continue;
+#endif
+            if (bytesWritten <= 0)
+                return false;
+            data += bytesWritten;
+            size -= size_t(bytesWritten);
+        }
+        return true;
+    };
+}
 
-    // Read the JSON message into output
-    output.resize(contentLength);
-    input.read(&output[0], contentLength);
-    return true;
+void MessageWriter::write(std::string message, const std::optional<std::string>& supersedeKey)
+{
+    {
+        std::unique_lock lock(mutex);
+        auto sequence = ++nextSequence;
+        if (supersedeKey)
+            latestSequence.insert_or_assign(*supersedeKey, sequence);
+        queue.push_back(QueuedMessage{std::move(message), supersedeKey, sequence});
+    }
+    condition.notify_one();
 }
 
-/// Sends a raw JSON-RPC message to output stream
-void sendRawMessage(std::ostream& output, const json& message)
+void MessageWriter::flush()
 {
-    std::string s = message.dump();
-    output << "Content-Length: " << s.length() << "\r\n";
-    output << "\r\n";
-    output << s;
-    output.flush();
+    std::unique_lock lock(mutex);
+    auto sequence = nextSequence;
+    flushedCondition.wait(lock,
+        [&]
+        {
+            return writtenSequence >= sequence;
+        });
+}
+
+void MessageWriter::writerLoop()
+{
+    std::deque<QueuedMessage> pending;
+    std::string output;
+    bool closed = false;
+
+    while (true)
+    {
+        size_t lastSequence = 0;
+
+        {
+            std::unique_lock lock(mutex);
+            condition.wait(lock,
+                [this]
+                {
+                    return stopping || !queue.empty();
+                });
+
+            // Drain any remaining messages before stopping
+            if (queue.empty())
+                return;
+
+            pending.swap(queue);
+            output.clear();
+            for (auto& queued : pending)
+            {
+                // Drop the message if a newer one has superseded it
+                if (queued.supersedeKey)
+                {
+                    auto it = latestSequence.find(*queued.supersedeKey);
+                    if (it->second != queued.sequence)
+                        continue;
+                    latestSequence.erase(it);
+                }
+
+                output += "Content-Length: ";
+                output += std::to_string(queued.message.size());
+                output += "\r\n\r\n";
+                output += queued.message;
+            }
+            lastSequence = pending.back().sequence;
+            pending.clear();
+        }
+
+        // If the client has closed the output, there is nothing we can do apart from drop the messages
+        if (!closed && !output.empty())
+            closed = !writeFn(output.data(), output.size());
+
+        {
+            std::unique_lock lock(mutex);
+            writtenSequence = lastSequence;
+        }
+        flushedCondition.notify_all();
+    }
 }
 
-} // namespace json_rpc
\ No newline at end of file
+} // namespace json_rpc
@@ -4,6 +4,9 @@
 #include <variant>
 #include <exception>
 #include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <future>
 
 #include "LSP/Uri.hpp"
 #include "LSP/DocumentationParser.hpp"
@@ -15,15 +18,18 @@
 #define REQUIRED_PARAMS(params, method) \
     (!(params) ? throw json_rpc::JsonRpcException(lsp::ErrorCode::InvalidParams, "params not provided for " method) : (params).value())
 
-LanguageServer::LanguageServer(const std::vector<std::filesystem::path>& definitionsFiles,
-    const std::vector<std::filesystem::path>& documentationFiles, const std::optional<Luau::Config>& defaultConfig)
-    : client(std::make_shared<Client>())
+LanguageServer::LanguageServer(ClientPtr client, const std::vector<std::filesystem::path>& definitionsFiles,
+    const std::vector<std::filesystem::path>& documentationFiles, const std::optional<Luau::Config>& defaultConfig,
+    const std::optional<std::filesystem::path>& statisticsFile)
+    : client(std::move(client))
     , defaultConfig(defaultConfig)
+    , statisticsFile(statisticsFile)
 {
-    client->definitionsFiles = definitionsFiles;
-    client->documentationFiles = documentationFiles;
-    parseDocumentation(documentationFiles, client->documentation, client);
-    nullWorkspace = std::make_shared<WorkspaceFolder>(client, "$NULL_WORKSPACE", Uri(), defaultConfig);
+    // NOTE: the `client` parameter has been moved from, so the member must be used
+    this->client->definitions = DefinitionsSnapshot::load(definitionsFiles);
+    this->client->documentationFiles = documentationFiles;
+    parseDocumentation(documentationFiles, this->client->documentation, this->client);
+    nullWorkspace = std::make_shared<WorkspaceFolder>(this->client, "$NULL_WORKSPACE", Uri(), defaultConfig);
 }
 
 /// Finds the workspace which the file belongs to.
@@ -120,7 +126,8 @@ lsp::ServerCapabilities LanguageServer::getServerCapabilities()
     return capabilities;
 }
 
-void LanguageServer::onRequest(const id_type& id, const std::string& method, std::optional<json> baseParams)
+void LanguageServer::onRequest(
+    const id_type& id, const std::string& method, std::optional<json> baseParams, const LSPCancellationToken& cancellationToken)
 {
     // Handle request
     // If a request has been sent before the server is initialized, we should error
@@ -142,7 +149,7 @@ void LanguageServer::onRequest(const id_type& id, const std::string& method, std
     }
     else if (method == "textDocument/completion")
     {
-        response = completion(REQUIRED_PARAMS(baseParams, "textDocument/completion"));
+        response = completion(REQUIRED_PARAMS(baseParams, "textDocument/completion"), cancellationToken);
     }
     else if (method == "textDocument/documentLink")
     {
@@ -150,11 +157,11 @@ void LanguageServer::onRequest(const id_type& id, const std::string& method, std
     }
     else if (method == "textDocument/hover")
     {
-        response = hover(REQUIRED_PARAMS(baseParams, "textDocument/hover"));
+        response = hover(REQUIRED_PARAMS(baseParams, "textDocument/hover"), cancellationToken);
     }
     else if (method == "textDocument/signatureHelp")
     {
-        response = signatureHelp(REQUIRED_PARAMS(baseParams, "textDocument/signatureHelp"));
+        response = signatureHelp(REQUIRED_PARAMS(baseParams, "textDocument/signatureHelp"), cancellationToken);
     }
     else if (method == "textDocument/definition")
     {
@@ -166,11 +173,11 @@ void LanguageServer::onRequest(const id_type& id, const std::string& method, std
     }
     else if (method == "textDocument/references")
     {
-        response = references(REQUIRED_PARAMS(baseParams, "textDocument/references"));
+        response = references(REQUIRED_PARAMS(baseParams, "textDocument/references"), cancellationToken);
     }
     else if (method == "textDocument/rename")
     {
-        response = rename(REQUIRED_PARAMS(baseParams, "textDocument/rename"));
+        response = rename(REQUIRED_PARAMS(baseParams, "textDocument/rename"), cancellationToken);
     }
     else if (method == "textDocument/documentSymbol")
     {
@@ -212,7 +219,7 @@ void LanguageServer::onRequest(const id_type& id, const std::string& method, std
         ASSERT_PARAMS(baseParams, "callHierarchy/incomingCalls");
         auto params = baseParams->get<lsp::CallHierarchyIncomingCallsParams>();
         auto workspace = findWorkspace(params.item.uri);
-        response = workspace->callHierarchyIncomingCalls(params);
+        response = workspace->callHierarchyIncomingCalls(params, cancellationToken);
     }
     else if (method == "callHierarchy/outgoingCalls")
     {
@@ -230,21 +237,13 @@ void LanguageServer::onRequest(const id_type& id, const std::string& method, std
     }
     else if (method == "textDocument/diagnostic")
     {
-        response = documentDiagnostic(REQUIRED_PARAMS(baseParams, "textDocument/diagnostic"));
+        response = documentDiagnostic(REQUIRED_PARAMS(baseParams, "textDocument/diagnostic"), cancellationToken);
     }
     else if (method == "workspace/diagnostic")
     {
-        // This request has partial request support.
-        // If workspaceDiagnostic returns nothing, then we don't signal a response (as data will be sent as progress notifications)
-        if (auto report = workspaceDiagnostic(REQUIRED_PARAMS(baseParams, "workspace/diagnostic")))
-        {
-            response = report;
-        }
-        else
-        {
-            client->workspaceDiagnosticsRequestId = id;
-            return;
-        }
+        // This request is computed in the background, so the response is sent once it completes
+        workspaceDiagnostic(id, REQUIRED_PARAMS(baseParams, "workspace/diagnostic"), cancellationToken);
+        return;
     }
     else if (method == "workspace/symbol")
     {
@@ -260,6 +259,10 @@ void LanguageServer::onRequest(const id_type& id, const std::string& method, std
         }
         response = result;
     }
+    else if (method == "luau-lsp/stats")
+    {
+        response = statistics().toJson();
+    }
     else
     {
         throw JsonRpcException(lsp::ErrorCode::MethodNotFound, "method not found / supported: " + method);
@@ -278,7 +281,9 @@ void LanguageServer::onNotification(const std::string& method, std::optional<jso
 
     if (method == "exit")
     {
-        // Exit the process loop
+        // Exit the process loop. Make sure any queued messages (e.g. the shutdown response) are written out first
+        dumpStatistics();
+        client->flush();
         std::exit(shutdownRequested ? 0 : 1);
     }
     else if (method == "initialized")
@@ -291,8 +296,7 @@ void LanguageServer::onNotification(const std::string& method, std::optional<jso
     }
     else if (method == "$/cancelRequest")
     {
-        // NO-OP
-        // TODO: support cancellation
+        // NO-OP: handled in processInputLoop, as it must not wait on the workspace lock held by the request being cancelled
     }
     else if (method == "textDocument/didOpen")
     {
@@ -336,52 +340,372 @@ void LanguageServer::onNotification(const std::string& method, std::optional<jso
     }
 }
 
-void LanguageServer::processInputLoop()
+bool LanguageServer::isReadOnlyRequest(const std::string& method)
+{
+    // NOTE: requests which typecheck (e.g. hover and semantic tokens) are deliberately excluded. A check can replace the checked
+    // modules of other requests' dependencies (e.g. `checkStrict` re-checks modules checked without their type graphs), freeing
+    // the type arenas those requests' types point into, so serialising `Frontend::check` alone would not make them safe to overlap
+    return method == "textDocument/documentSymbol" || method == "textDocument/foldingRange" || method == "textDocument/documentLink" ||
+           method == "textDocument/documentColor" || method == "textDocument/colorPresentation" || method == "luau-lsp/stats";
+}
+
+TaskPriority LanguageServer::requestPriority(const std::string& method)
+{
+    if (method == "textDocument/completion" || method == "textDocument/signatureHelp" || method == "textDocument/hover")
+        return TaskPriority::Interactive;
+    return TaskPriority::Normal;
+}
+
+std::unique_lock<std::shared_mutex> LanguageServer::lockForMutation()
+{
+    {
+        std::unique_lock lock(pendingRequestsMutex);
+        pendingRequestsCondition.wait(lock,
+            [this]
+            {
+                return pendingRequests == 0;
+            });
+    }
+    return std::unique_lock(workspaceMutex);
+}
+
+std::optional<std::unique_lock<std::shared_mutex>> LanguageServer::tryLockForBackgroundWork()
 {
-    std::string jsonString;
-    while (std::cin)
     {
-        if (client->readRawMessage(jsonString))
+        std::unique_lock lock(pendingRequestsMutex);
+
+        // We wait a short while rather than indefinitely, so that the worker is not held up if the requests are
+        // themselves waiting on a worker to become available
+        if (!pendingRequestsCondition.wait_for(lock, std::chrono::milliseconds(10),
+                [this]
+                {
+                    return pendingRequests == 0;
+                }))
+            return std::nullopt;
+    }
+    return std::unique_lock(workspaceMutex);
+}
+
+void LanguageServer::scheduleBackgroundWork(std::function<bool()> step)
+{
+    workerPool.push(
+        [this, step = std::move(step)]() mutable
         {
-            // sendTrace(jsonString, std::nullopt);
-            std::optional<id_type> id = std::nullopt;
+            auto lock = tryLockForBackgroundWork();
+            if (!lock)
+            {
+                // Give way to the requests, and try again later
+                scheduleBackgroundWork(std::move(step));
+                return;
+            }
+
+            if (shutdownRequested)
+                return;
+
+            bool hasMoreWork = false;
             try
             {
-                // Parse the input
-                auto msg = json_rpc::parse(jsonString);
-                id = msg.id;
+                hasMoreWork = step();
+            }
+            catch (const RequestCancelledException&)
+            {
+                // The work was abandoned part-way through a step, so there is nothing left to do
+                hasMoreWork = false;
+            }
+            catch (const std::exception& e)
+            {
+                // Log the failure, but continue on with the remaining work
+                client->sendLogMessage(lsp::MessageType::Error, std::string("background work failed: ") + e.what());
+                hasMoreWork = true;
+            }
 
-                if (msg.is_request())
-                {
-                    onRequest(msg.id.value(), msg.method.value(), msg.params);
-                }
-                else if (msg.is_response())
-                {
-                    client->handleResponse(msg);
-                }
-                else if (msg.is_notification())
-                {
-                    onNotification(msg.method.value(), msg.params);
-                }
-                else
+            if (hasMoreWork)
+                scheduleBackgroundWork(std::move(step));
+        },
+        TaskPriority::Background);
+}
+
+void LanguageServer::scheduleDelayedWork(std::chrono::milliseconds delay, std::function<void()> work)
+{
+    workerPool.pushAfter(delay,
+        [this, work = std::move(work)]() mutable
+        {
+            auto lock = tryLockForBackgroundWork();
+            if (!lock)
+            {
+                // Give way to the requests, and try again once they have run
+                scheduleDelayedWork(std::chrono::milliseconds(0), std::move(work));
+                return;
+            }
+
+            if (shutdownRequested)
+                return;
+
+            try
+            {
+                work();
+            }
+            catch (const std::exception& e)
+            {
+                client->sendLogMessage(lsp::MessageType::Error, std::string("delayed work failed: ") + e.what());
+            }
+        });
+}
+
+void LanguageServer::handleRequest(
+    const id_type& id, const std::string& method, const std::optional<json>& params, const LSPCancellationToken& cancellationToken)
+{
+    try
+    {
+        // The request may have been cancelled whilst it was queued
+        throwIfCancelled(cancellationToken);
+        ScopedTimer timer(Statistics::Requests, method);
+        onRequest(id, method, params, cancellationToken);
+    }
+    catch (const RequestCancelledException&)
+    {
+        client->sendError(id, JsonRpcException(lsp::ErrorCode::RequestCancelled, "request cancelled"));
+    }
+    catch (const JsonRpcException& e)
+    {
+        client->sendError(id, e);
+    }
+    catch (const json::exception& e)
+    {
+        client->sendError(id, JsonRpcException(lsp::ErrorCode::ParseError, e.what()));
+    }
+    catch (const std::exception& e)
+    {
+        client->sendError(id, JsonRpcException(lsp::ErrorCode::InternalError, e.what()));
+    }
+}
+
+void LanguageServer::dispatchRequest(const id_type& id, const std::string& method, std::optional<json> params)
+{
+    // Lifecycle requests are applied as mutations, as every other message depends on their outcome
+    if (method == "initialize" || method == "shutdown")
+    {
+        dispatchMutation(
+            [this, id, method, params = std::move(params)]()
+            {
+                handleRequest(id, method, params, nullptr);
+            });
+        return;
+    }
+
+    // The token is registered straight away, so that the request can be cancelled whilst it is still waiting in the dispatch queue
+    auto cancellationToken = std::make_shared<CancellationToken>();
+    {
+        std::unique_lock lock(cancellationTokensMutex);
+        cancellationTokens.insert_or_assign(id, cancellationToken);
+    }
+
+    dispatchQueue.push(
+        [this, id, method, params = std::move(params), cancellationToken, queuedAt = std::chrono::steady_clock::now()]() mutable
+        {
+            {
+                std::unique_lock lock(pendingRequestsMutex);
+                pendingRequests++;
+            }
+
+            workerPool.push(
+                [this, id, method, params = std::move(params), cancellationToken, queuedAt]()
                 {
-                    throw JsonRpcException(lsp::ErrorCode::InvalidRequest, "invalid json-rpc message");
-                }
+                    auto markStarted = [&]()
+                    {
+                        statistics().record(Statistics::QueueWait, method, std::chrono::steady_clock::now() - queuedAt);
+                        {
+                            std::unique_lock lock(pendingRequestsMutex);
+                            pendingRequests--;
+                        }
+                        pendingRequestsCondition.notify_all();
+                    };
+
+                    if (isReadOnlyRequest(method))
+                    {
+                        std::shared_lock lock(workspaceMutex);
+                        markStarted();
+                        handleRequest(id, method, params, cancellationToken);
+                    }
+                    else
+                    {
+                        std::unique_lock lock(workspaceMutex);
+                        markStarted();
+                        handleRequest(id, method, params, cancellationToken);
+                    }
+
+                    // Workspace diagnostics are computed in the background once the handler returns, and the background work
+                    // releases the token once it completes
+                    if (method != "workspace/diagnostic" || !client->isWorkspaceDiagnosticsRequest(id))
+                        releaseCancellationToken(id, cancellationToken);
+                },
+                requestPriority(method));
+        });
+}
+
+void LanguageServer::releaseCancellationToken(const id_type& id, const LSPCancellationToken& cancellationToken)
+{
+    std::unique_lock lock(cancellationTokensMutex);
+    if (auto it = cancellationTokens.find(id); it != cancellationTokens.end() && it->second == cancellationToken)
+        cancellationTokens.erase(it);
+}
+
+void LanguageServer::dispatchNotification(const std::string& method, std::optional<json> params)
+{
+    dispatchMutation(
+        [this, method, params = std::move(params), queuedAt = std::chrono::steady_clock::now()]() mutable
+        {
+            statistics().record(Statistics::QueueWait, method, std::chrono::steady_clock::now() - queuedAt);
+
+            ScopedTimer timer(Statistics::Notifications, method);
+            onNotification(method, std::move(params));
+        });
+}
+
+void LanguageServer::dispatchMutation(std::function<void()> mutation)
+{
+    dispatchQueue.push(
+        [this, mutation = std::move(mutation)]()
+        {
+            auto lock = lockForMutation();
+            try
+            {
+                mutation();
             }
             catch (const JsonRpcException& e)
             {
-                client->sendError(id, e);
+                client->sendError(std::nullopt, e);
             }
             catch (const json::exception& e)
             {
-                client->sendError(id, JsonRpcException(lsp::ErrorCode::ParseError, e.what()));
+                client->sendError(std::nullopt, JsonRpcException(lsp::ErrorCode::ParseError, e.what()));
             }
             catch (const std::exception& e)
             {
-                client->sendError(id, JsonRpcException(lsp::ErrorCode::InternalError, e.what()));
+                client->sendError(std::nullopt, JsonRpcException(lsp::ErrorCode::InternalError, e.what()));
+            }
+        });
+}
+
+void LanguageServer::onCancelRequest(const lsp::CancelParams& params)
+{
+    {
+        std::unique_lock lock(cancellationTokensMutex);
+        if (auto it = cancellationTokens.find(params.id); it != cancellationTokens.end())
+        {
+            it->second->cancel();
+            return;
+        }
+    }
+
+    // The request may be a workspace diagnostics request which has completed, but is still streaming partial results
+    client->cancelWorkspaceDiagnostics(params.id);
+}
+
+void LanguageServer::processMessage(std::string_view jsonString)
+{
+    // sendTrace(jsonString, std::nullopt);
+    std::optional<id_type> id = std::nullopt;
+    try
+    {
+        // Parse the input
+        auto msg = json_rpc::parse(jsonString);
+        id = msg.id;
+
+        if (msg.is_request())
+        {
+            // Requests are executed on the worker pool, so that we can continue to read in messages
+            dispatchRequest(msg.id.value(), msg.method.value(), std::move(msg.params));
+        }
+        else if (msg.is_response())
+        {
+            // Response handlers (e.g. for configuration requests) may update the workspace
+            dispatchMutation(
+                [this, msg = std::move(msg)]()
+                {
+                    client->handleResponse(msg);
+                });
+        }
+        else if (msg.is_notification())
+        {
+            // Cancellation is processed immediately, as the request being cancelled may be holding the workspace lock
+            if (msg.method == "$/cancelRequest")
+            {
+                onCancelRequest(REQUIRED_PARAMS(msg.params, "$/cancelRequest"));
             }
+            else
+            {
+                // Notifications (such as document changes) are applied in the order they are received
+                dispatchNotification(msg.method.value(), std::move(msg.params));
+            }
+        }
+        else
+        {
+            throw JsonRpcException(lsp::ErrorCode::InvalidRequest, "invalid json-rpc message");
         }
     }
+    catch (const JsonRpcException& e)
+    {
+        client->sendError(id, e);
+    }
+    catch (const json::exception& e)
+    {
+        client->sendError(id, JsonRpcException(lsp::ErrorCode::ParseError, e.what()));
+    }
+    catch (const std::exception& e)
+    {
+        client->sendError(id, JsonRpcException(lsp::ErrorCode::InternalError, e.what()));
+    }
+}
+
+void LanguageServer::processInputLoop()
+{
+    std::string_view jsonString;
+    while (client->readRawMessage(jsonString))
+    {
+        if (recorder)
+            recorder->record(jsonString);
+        processMessage(jsonString);
+    }
+}
+
+void LanguageServer::recordSession(const std::filesystem::path& path)
+{
+    recorder = std::make_unique<SessionRecorder>(path);
+    if (!recorder->isOpen())
+    {
+        std::cerr << "Failed to open '" << path.generic_string() << "' to record the session\n";
+        recorder = nullptr;
+    }
+}
+
+void LanguageServer::waitForPendingRequests()
+{
+    // Messages are handed off in order, so once the dispatch queue reaches this task every earlier request has been dispatched
+    std::promise<void> dispatched;
+    dispatchQueue.push(
+        [&dispatched]()
+        {
+            dispatched.set_value();
+        });
+    dispatched.get_future().wait();
+
+    // Once we can acquire an exclusive lock, every previously dispatched request has completed
+    auto lock = lockForMutation();
+}
+
+void LanguageServer::dumpStatistics()
+{
+    if (!statisticsFile)
+        return;
+
+    std::ofstream output(*statisticsFile);
+    if (!output)
+    {
+        std::cerr << "Failed to write statistics to '" << statisticsFile->generic_string() << "'\n";
+        return;
+    }
+    output << statistics().toJson().dump(4) << "\n";
 }
 
 bool LanguageServer::requestedShutdown()
@@ -444,18 +768,18 @@ void LanguageServer::onInitialized(const lsp::InitializedParams& params)
 
         client->registerCapability("didChangeConfigurationCapability", "workspace/didChangeConfiguration", nullptr);
         client->configChangedCallback =
-            [&](const lsp::DocumentUri& workspaceUri, const ClientConfiguration& config, const ClientConfiguration* oldConfig)
+            [&](const lsp::DocumentUri& workspaceUri, const ClientConfigurationPtr& config, const ClientConfigurationPtr& oldConfig)
         {
             auto workspace = findWorkspace(workspaceUri);
 
             // Update the workspace setup with the new configuration
-            workspace->setupWithConfiguration(config);
+            workspace->setupWithConfiguration(*config);
 
             // Refresh diagnostics
             this->recomputeDiagnostics(workspace, config);
 
             // Refresh inlay hint if changed
-            if (!oldConfig || oldConfig->inlayHints != config.inlayHints)
+            if (!oldConfig || oldConfig->inlayHints != config->inlayHints)
                 client->refreshInlayHints();
         };
 
@@ -476,6 +800,8 @@ void LanguageServer::onInitialized(const lsp::InitializedParams& params)
         watchers.push_back(lsp::FileSystemWatcher{"**/.luaurc"});
         watchers.push_back(lsp::FileSystemWatcher{"**/sourcemap.json"});
         watchers.push_back(lsp::FileSystemWatcher{"**/*.{lua,luau}"});
+        // Directories being created or deleted (e.g. when moved) may not be reported as changes to each of the files within them
+        watchers.push_back(lsp::FileSystemWatcher{"**/*", lsp::WatchKind::Create | lsp::WatchKind::Delete});
         client->registerCapability(
             "didChangedWatchedFilesCapability", "workspace/didChangeWatchedFiles", lsp::DidChangeWatchedFilesRegistrationOptions{watchers});
     }
@@ -492,18 +818,28 @@ void LanguageServer::onInitialized(const lsp::InitializedParams& params)
     // a race condition where the first LSP events are executed before receiving the user configuration,
     // causing us to fall back to the global configuration. Sending the request for configuration
     // first means we receive the user config before processing the first LSP events
-    nullWorkspace->initialize();
-    nullWorkspace->setupWithConfiguration(client->globalConfig);
-    for (auto& folder : workspaceFolders)
-    {
-        folder->initialize();
-        // Client does not support retrieving configuration information, so we just setup the workspaces with the default, global, configuration
-        if (!requestedConfiguration)
-            folder->setupWithConfiguration(client->globalConfig);
-    }
+    std::vector<WorkspaceFolderPtr> workspaces{nullWorkspace};
+    workspaces.insert(workspaces.end(), workspaceFolders.begin(), workspaceFolders.end());
+    initializeWorkspaces(workspaces);
+
+    nullWorkspace->setupWithConfiguration(*client->getGlobalConfiguration());
+    // Client does not support retrieving configuration information, so we just setup the workspaces with the default, global, configuration
+    if (!requestedConfiguration)
+        for (auto& folder : workspaceFolders)
+            folder->setupWithConfiguration(*client->getGlobalConfiguration());
 }
 
-void LanguageServer::pushDiagnostics(WorkspaceFolderPtr& workspace, const lsp::DocumentUri& uri, const size_t version)
+void LanguageServer::initializeWorkspaces(const std::vector<WorkspaceFolderPtr>& workspaces)
+{
+    // NOTE: workspaces are initialised one after another. Each frontend's global environment cannot be shared with the others,
+    // as the sourcemap instance types of a workspace are added onto its global class types. Loading the environments concurrently
+    // is not known to be safe either, as every workspace registers its definitions through the shared client
+    for (const auto& workspace : workspaces)
+        workspace->initialize();
+}
+
+lsp::DocumentDiagnosticReport LanguageServer::pushDiagnostics(
+    WorkspaceFolderPtr& workspace, const lsp::DocumentUri& uri, const std::optional<size_t> version)
 {
     // Convert the diagnostics report into a series of diagnostics published for each relevant file
     lsp::DocumentDiagnosticParams params{lsp::TextDocumentIdentifier{uri}};
@@ -520,31 +856,141 @@ void LanguageServer::pushDiagnostics(WorkspaceFolderPtr& workspace, const lsp::D
             }
         }
     }
+
+    return diagnostics;
+}
+
+void LanguageServer::pushDependentDiagnostics(const WorkspaceFolderPtr& workspace, const std::vector<Uri>& uris)
+{
+    auto& pending = pendingDependentDiagnostics[workspace];
+    for (const auto& uri : uris)
+        if (pending.queued.insert(uri.toString()).second)
+            pending.queue.push_back(uri);
+
+    if (pending.scheduled || pending.queue.empty())
+        return;
+    pending.scheduled = true;
+
+    scheduleBackgroundWork(
+        [this, workspace]() mutable
+        {
+            auto& pending = pendingDependentDiagnostics[workspace];
+            if (pending.queue.empty())
+            {
+                pending.scheduled = false;
+                return false;
+            }
+
+            auto uri = pending.queue.front();
+            pending.queue.pop_front();
+            pending.queued.erase(uri.toString());
+
+            pushDiagnostics(workspace, uri, std::nullopt);
+
+            if (pending.queue.empty())
+            {
+                pending.scheduled = false;
+                return false;
+            }
+            return true;
+        });
+}
+
+void LanguageServer::pushDebouncedDiagnostics(
+    const WorkspaceFolderPtr& workspace, const lsp::DocumentUri& uri, std::vector<Uri> dependents, std::chrono::milliseconds debounce)
+{
+    auto& pending = debouncedDiagnostics[uri.toString()];
+    pending.workspace = workspace;
+    pending.dependents.insert(pending.dependents.end(), std::make_move_iterator(dependents.begin()), std::make_move_iterator(dependents.end()));
+    auto generation = ++pending.generation;
+
+    scheduleDelayedWork(debounce,
+        [this, uri, generation]()
+        {
+            // The file was edited again within the window, so the recomputation scheduled by that edit will handle it
+            auto it = debouncedDiagnostics.find(uri.toString());
+            if (it == debouncedDiagnostics.end() || it->second.generation != generation)
+                return;
+
+            auto workspace = it->second.workspace;
+            auto dependents = std::move(it->second.dependents);
+            debouncedDiagnostics.erase(it);
+
+            // The file may have been closed in the meantime, in which case its diagnostics have already been handled
+            std::unordered_map<std::string, lsp::SingleDocumentDiagnosticReport> relatedDocuments;
+            if (auto document = workspace->fileResolver.getTextDocument(uri))
+                relatedDocuments = pushDiagnostics(workspace, uri, document->version()).relatedDocuments;
+
+            // Only now that the edited file has settled do we recompute its reverse dependencies
+            dependents.erase(std::remove_if(dependents.begin(), dependents.end(),
+                                 [&](const Uri& dependent)
+                                 {
+                                     return dependent == uri || contains(relatedDocuments, dependent.toString());
+                                 }),
+                dependents.end());
+            pushDependentDiagnostics(workspace, dependents);
+        });
 }
 
 /// Recompute all necessary diagnostics when we detect a configuration (or sourcemap) change
-void LanguageServer::recomputeDiagnostics(WorkspaceFolderPtr& workspace, const ClientConfiguration& config)
+/// In push-mode, the diagnostics are recomputed in the background a module at a time
+void LanguageServer::recomputeDiagnostics(WorkspaceFolderPtr& workspace, const ClientConfigurationPtr& config)
 {
     // Handle diagnostics if in push-mode
     if ((!client->capabilities.textDocument || !client->capabilities.textDocument->diagnostic))
     {
+        // Abandon any previous recomputation, as it is now stale
+        auto& cancellationToken = recomputeDiagnosticsTokens[workspace];
+        if (cancellationToken)
+            cancellationToken->cancel();
+        cancellationToken = std::make_shared<CancellationToken>();
+
         // Recompute workspace diagnostics if requested
-        if (config.diagnostics.workspace)
+        if (config->diagnostics.workspace)
         {
-            auto diagnostics = workspace->workspaceDiagnostics({});
-            for (const auto& report : diagnostics.items)
-            {
-                if (report.kind == lsp::DocumentDiagnosticReportKind::Full)
+            auto files = workspace->findWorkspaceDiagnosticsFiles(*config);
+            scheduleBackgroundWork(
+                [this, workspace, config, files = std::move(files), cancellationToken, next = size_t(0)]() mutable
                 {
-                    client->publishDiagnostics(lsp::PublishDiagnosticsParams{report.uri, report.version, report.items});
-                }
-            }
+                    if (cancellationToken->requested() || next >= files.size())
+                        return false;
+
+                    // Files are typechecked in parallel a batch at a time
+                    auto batchEnd = std::min(next + WorkspaceDiagnosticsBatchSize, files.size());
+                    std::vector<Uri> batch(files.begin() + next, files.begin() + batchEnd);
+                    next = batchEnd;
+
+                    for (const auto& report : workspace->workspaceDocumentDiagnostics(batch, *config, cancellationToken))
+                        if (report.kind == lsp::DocumentDiagnosticReportKind::Full)
+                            client->publishDiagnostics(lsp::PublishDiagnosticsParams{report.uri, report.version, report.items});
+
+                    if (next < files.size())
+                        return true;
+
+                    workspace->saveDiagnosticsCache();
+                    return false;
+                });
         }
         // Recompute diagnostics for all currently opened files
         else
         {
+            std::vector<Uri> files;
             for (const auto& [_, document] : workspace->fileResolver.managedFiles)
-                this->pushDiagnostics(workspace, document.uri(), document.version());
+                files.push_back(document.uri());
+
+            scheduleBackgroundWork(
+                [this, workspace, files = std::move(files), cancellationToken, next = size_t(0)]() mutable
+                {
+                    if (cancellationToken->requested() || next >= files.size())
+                        return false;
+
+                    // The file may have been closed in the meantime
+                    const auto& uri = files[next++];
+                    if (auto document = workspace->fileResolver.getTextDocument(uri))
+                        this->pushDiagnostics(workspace, uri, document->version());
+
+                    return next < files.size();
+                });
         }
     }
     else
@@ -554,6 +1000,53 @@ void LanguageServer::recomputeDiagnostics(WorkspaceFolderPtr& workspace, const C
     }
 }
 
+void LanguageServer::schedulePreTypecheck(const WorkspaceFolderPtr& workspace)
+{
+    auto& cancellationToken = preTypecheckTokens[workspace];
+    if (cancellationToken)
+        cancellationToken->cancel();
+    cancellationToken = std::make_shared<CancellationToken>();
+
+    auto config = client->getConfiguration(workspace->rootUri);
+    if (!config->index.preTypecheck)
+        return;
+
+    // Wait until documents have stopped changing, so that we are not typechecking modules which will immediately be marked dirty again
+    scheduleDelayedWork(std::chrono::milliseconds(500),
+        [this, workspace, cancellationToken]()
+        {
+            if (cancellationToken->requested())
+                return;
+
+            std::vector<Luau::ModuleName> documents;
+            for (const auto& [_, document] : workspace->fileResolver.managedFiles)
+                documents.push_back(workspace->fileResolver.getModuleName(document.uri()));
+
+            // Typecheck a single module per step, so that the work stops as soon as any requests come in
+            scheduleBackgroundWork(
+                [workspace, cancellationToken, documents = std::move(documents), nextDocument = size_t(0),
+                    modules = std::vector<Luau::ModuleName>{}, nextModule = size_t(0)]() mutable
+                {
+                    if (cancellationToken->requested())
+                        return false;
+
+                    // The require closure of a document is only found once we get to it, as the previous documents may share
+                    // some of their dependencies
+                    while (nextModule >= modules.size())
+                    {
+                        if (nextDocument >= documents.size())
+                            return false;
+
+                        modules = workspace->findUncheckedRequireClosure(documents[nextDocument++]);
+                        nextModule = 0;
+                    }
+
+                    workspace->checkStrict(modules[nextModule++], /* forAutocomplete: */ true);
+                    return nextModule < modules.size() || nextDocument < documents.size();
+                });
+        });
+}
+
 void LanguageServer::onDidOpenTextDocument(const lsp::DidOpenTextDocumentParams& params)
 {
     // Start managing the file in-memory
@@ -567,6 +1060,8 @@ void LanguageServer::onDidOpenTextDocument(const lsp::DidOpenTextDocumentParams&
     {
         pushDiagnostics(workspace, params.textDocument.uri, params.textDocument.version);
     }
+
+    schedulePreTypecheck(workspace);
 }
 
 void LanguageServer::onDidChangeTextDocument(const lsp::DidChangeTextDocumentParams& params)
@@ -583,46 +1078,28 @@ void LanguageServer::onDidChangeTextDocument(const lsp::DidChangeTextDocumentPar
     // however if a client doesn't yet support it, we push the diagnostics instead
     if (!client->capabilities.textDocument || !client->capabilities.textDocument->diagnostic)
     {
-        // Convert the diagnostics report into a series of diagnostics published for each relevant file
-        auto diagnostics = workspace->documentDiagnostics(lsp::DocumentDiagnosticParams{{params.textDocument.uri}});
-        client->publishDiagnostics(lsp::PublishDiagnosticsParams{params.textDocument.uri, params.textDocument.version, diagnostics.items});
-
-        // Compute diagnostics for reverse dependencies
+        // Diagnostics are only recomputed once the file has settled, so that fast typing does not recheck the file
+        // (and all of its reverse dependencies) on every keystroke
+        // Reverse dependencies are recomputed in the background afterwards, a module at a time, so that they do not hold up other requests
         // TODO: should we put this inside documentDiagnostics so it works in the pull based model as well? (its a reverse BFS which is expensive)
         // TODO: maybe this should only be done onSave
         auto config = client->getConfiguration(workspace->rootUri);
-        if (config.diagnostics.includeDependents || config.diagnostics.workspace)
+        std::vector<Uri> dependents{};
+        if (config->diagnostics.includeDependents || config->diagnostics.workspace)
         {
-            std::unordered_map<std::string, lsp::SingleDocumentDiagnosticReport> reverseDependencyDiagnostics{};
             for (auto& module : markedDirty)
             {
                 auto filePath = workspace->fileResolver.resolveToRealPath(module);
-                if (filePath)
-                {
-                    auto uri = Uri::file(*filePath);
-                    if (uri != params.textDocument.uri && !contains(diagnostics.relatedDocuments, uri.toString()) &&
-                        !workspace->isIgnoredFile(*filePath, config))
-                    {
-                        auto dependencyDiags = workspace->documentDiagnostics(lsp::DocumentDiagnosticParams{{uri}});
-                        diagnostics.relatedDocuments.emplace(uri.toString(),
-                            lsp::SingleDocumentDiagnosticReport{dependencyDiags.kind, dependencyDiags.resultId, dependencyDiags.items});
-                        diagnostics.relatedDocuments.merge(dependencyDiags.relatedDocuments);
-                    }
-                }
+                if (filePath && !workspace->isIgnoredFile(*filePath, *config))
+                    dependents.push_back(Uri::file(*filePath));
             }
         }
 
-        if (!diagnostics.relatedDocuments.empty())
-        {
-            for (const auto& [uri, diagnostics] : diagnostics.relatedDocuments)
-            {
-                if (diagnostics.kind == lsp::DocumentDiagnosticReportKind::Full)
-                {
-                    client->publishDiagnostics(lsp::PublishDiagnosticsParams{Uri::parse(uri), std::nullopt, diagnostics.items});
-                }
-            }
-        }
+        pushDebouncedDiagnostics(
+            workspace, params.textDocument.uri, std::move(dependents), std::chrono::milliseconds(config->diagnostics.pushDebounce));
     }
+
+    schedulePreTypecheck(workspace);
 }
 
 void LanguageServer::onDidCloseTextDocument(const lsp::DidCloseTextDocumentParams& params)
@@ -638,7 +1115,7 @@ void LanguageServer::onDidChangeConfiguration(const lsp::DidChangeConfigurationP
     // manually get it for all the workspaces again
     if (client->capabilities.workspace && client->capabilities.workspace->configuration)
     {
-        client->configStore.clear();
+        client->clearConfiguration();
 
         // Send off requests to get the configuration again for each workspace
         std::vector<lsp::DocumentUri> items{nullWorkspace->rootUri};
@@ -652,7 +1129,7 @@ void LanguageServer::onDidChangeConfiguration(const lsp::DidChangeConfigurationP
         // We can't assume its formed correctly, so lets wrap it in a try-catch
         try
         {
-            client->globalConfig = params.settings;
+            client->setGlobalConfiguration(params.settings.get<ClientConfiguration>());
         }
         catch (const std::exception& e)
         {
@@ -685,13 +1162,18 @@ void LanguageServer::onDidChangeWorkspaceFolders(const lsp::DidChangeWorkspaceFo
     }
 
     // Add new folders
+    std::vector<WorkspaceFolderPtr> addedFolders{};
     std::vector<lsp::DocumentUri> configItems{};
     for (auto& folder : params.event.added)
     {
-        workspaceFolders.emplace_back(std::make_shared<WorkspaceFolder>(client, folder.name, folder.uri, defaultConfig));
+        addedFolders.emplace_back(std::make_shared<WorkspaceFolder>(client, folder.name, folder.uri, defaultConfig));
         configItems.emplace_back(folder.uri);
     }
+    workspaceFolders.insert(workspaceFolders.end(), addedFolders.begin(), addedFolders.end());
+
+    // As on startup, the configuration is requested before the (slow) initialisation, so that it is received before any later events
     client->requestConfiguration(configItems);
+    initializeWorkspaces(addedFolders);
 }
 
 void LanguageServer::onDidChangeWatchedFiles(const lsp::DidChangeWatchedFilesParams& params)
@@ -722,8 +1204,13 @@ void LanguageServer::onDidChangeWatchedFiles(const lsp::DidChangeWatchedFilesPar
         }
         else if (filePath.extension() == ".lua" || filePath.extension() == ".luau")
         {
+            if (change.type == lsp::FileChangeType::Created)
+                workspace->fileInventory.add(filePath);
+            else if (change.type == lsp::FileChangeType::Deleted)
+                workspace->fileInventory.remove(filePath);
+
             // Notify if it was a definitions file
-            if (workspace->isDefinitionFile(filePath, config))
+            if (workspace->isDefinitionFile(filePath, *config))
             {
                 client->sendWindowMessage(
                     lsp::MessageType::Info, "Detected changes to global definitions files. Please reload your workspace for this to take effect");
@@ -732,25 +1219,43 @@ void LanguageServer::onDidChangeWatchedFiles(const lsp::DidChangeWatchedFilesPar
 
             // Index the workspace on changes
             // We only update the require graph. We do not perform type checking
-            if (config.index.enabled && workspace->isConfigured)
+            if (config->index.enabled && workspace->isConfigured)
             {
                 auto moduleName = workspace->fileResolver.getModuleName(change.uri);
 
                 std::vector<Luau::ModuleName> markedDirty{};
-                workspace->frontend.markDirty(moduleName, &markedDirty);
+                workspace->markDirty(moduleName, &markedDirty);
 
                 if (change.type == lsp::FileChangeType::Created)
-                    workspace->frontend.parse(moduleName);
+                    workspace->parseSourceModule(moduleName);
 
                 // Re-check the reverse dependencies
                 for (const auto& moduleName : markedDirty)
-                    workspace->frontend.parse(moduleName);
+                    workspace->parseSourceModule(moduleName);
             }
 
             // Clear the diagnostics for the file in case it was not managed
             if (change.type == lsp::FileChangeType::Deleted)
                 workspace->clearDiagnosticsForFile(change.uri);
         }
+        else if (workspace->isWithinExcludedDirectory(filePath, *config))
+        {
+            // The catch-all watcher reports every path created or deleted anywhere in the workspace (e.g. within `.git` or
+            // `node_modules`), none of which can contain relevant source files
+            continue;
+        }
+        else if (change.type == lsp::FileChangeType::Created)
+        {
+            // A directory may have been created (or moved in), containing source files. Rather than walking it now,
+            // the inventory is rebuilt the next time the source files are needed
+            std::error_code ec;
+            if (std::filesystem::is_directory(filePath, ec))
+                workspace->fileInventory.invalidate();
+        }
+        else if (change.type == lsp::FileChangeType::Deleted)
+        {
+            workspace->fileInventory.remove(filePath);
+        }
     }
 }
 
@@ -4,6 +4,8 @@
 #include "LSP/LuauExt.hpp"
 #include "LSP/Utils.hpp"
 
+#include <mutex>
+
 namespace types
 {
 std::optional<Luau::TypeId> getTypeIdForClass(const Luau::ScopePtr& globalScope, std::optional<std::string> className)
@@ -418,9 +420,11 @@ void registerInstanceTypes(Luau::Frontend& frontend, const Luau::GlobalTypes& gl
     }
 
     // Prepare module scope so that we can dynamically reassign the type of "script" to retrieve instance info
-    frontend.prepareModuleScope = [&frontend, &fileResolver, &arena, expressiveTypes](
+    // Modules may be typechecked in parallel, but the sourcemap types are allocated into the shared arena, so we must serialise access to it
+    frontend.prepareModuleScope = [&frontend, &fileResolver, &arena, expressiveTypes, mutex = std::make_shared<std::mutex>()](
                                       const Luau::ModuleName& name, const Luau::ScopePtr& scope, bool forAutocomplete)
     {
+        std::unique_lock lock(*mutex);
         Luau::GlobalTypes& globals = forAutocomplete ? frontend.globalsForAutocomplete : frontend.globals;
 
         // TODO: we hope to remove these in future!
@@ -0,0 +1,37 @@
+#include "LSP/ReferenceIndex.hpp"
+
+void ReferenceIndex::update(const std::string& moduleName, const std::vector<PropertyReference>& references)
+{
+    auto& properties = moduleReferences[moduleName];
+    properties.clear();
+    for (const auto& reference : references)
+        properties[reference.property].push_back(Use{reference.definitionModuleName, reference.definitionLocation, reference.location});
+}
+
+void ReferenceIndex::remove(const std::string& moduleName)
+{
+    moduleReferences.erase(moduleName);
+}
+
+void ReferenceIndex::clear()
+{
+    moduleReferences.clear();
+}
+
+std::vector<Luau::Location> ReferenceIndex::find(const std::string& moduleName, const std::string& definitionModuleName,
+    const Luau::Location& definitionLocation, const std::string& property) const
+{
+    auto properties = moduleReferences.find(moduleName);
+    if (properties == moduleReferences.end())
+        return {};
+
+    auto uses = properties->second.find(property);
+    if (uses == properties->second.end())
+        return {};
+
+    std::vector<Luau::Location> result;
+    for (const auto& use : uses->second)
+        if (use.definitionModuleName == definitionModuleName && use.definitionLocation == definitionLocation)
+            result.push_back(use.location);
+    return result;
+}
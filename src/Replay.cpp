@@ -0,0 +1,197 @@
+#include "LSP/Replay.hpp"
+#include "LSP/LanguageServer.hpp"
+#include "LSP/Statistics.hpp"
+#include "LSP/Uri.hpp"
+#include "LSP/Utils.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+SessionRecorder::SessionRecorder(const std::filesystem::path& path)
+    : output(path, std::ios::out | std::ios::trunc | std::ios::binary)
+    , startTime(std::chrono::steady_clock::now())
+{
+    // Times are written with a fixed number of decimal places, so that they keep millisecond resolution in long sessions
+    output << std::fixed << std::setprecision(3);
+}
+
+void SessionRecorder::record(std::string_view message)
+{
+    auto time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+    // The message is re-serialised so that it fits on a single line, as clients may send pretty-printed JSON.
+    // Invalid messages are kept as a string, so that they are still replayed exactly as they were received
+    std::string body;
+    try
+    {
+        body = json::parse(message).dump();
+    }
+    catch (const json::exception&)
+    {
+        body = json(std::string(message)).dump(-1, ' ', false, json::error_handler_t::replace);
+    }
+
+    output << R"({"time":)" << time << R"(,"message":)" << body << "}\n";
+    output.flush();
+}
+
+std::vector<RecordedMessage> loadRecordedSession(const std::filesystem::path& path)
+{
+    std::ifstream input(path, std::ios::in | std::ios::binary);
+    if (!input)
+        throw std::runtime_error("failed to open recorded session '" + path.generic_string() + "'");
+
+    std::vector<RecordedMessage> session;
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(input, line))
+    {
+        lineNumber++;
+        if (line.empty())
+            continue;
+
+        try
+        {
+            auto entry = json::parse(line);
+            const auto& message = entry.at("message");
+            // Invalid messages are recorded as a string of their original contents
+            auto contents = message.is_string() ? message.get<std::string>() : message.dump();
+            session.push_back(RecordedMessage{entry.at("time").get<double>(), std::move(contents)});
+        }
+        catch (const json::exception& e)
+        {
+            throw std::runtime_error(path.generic_string() + ":" + std::to_string(lineNumber) + ": " + e.what());
+        }
+    }
+
+    return session;
+}
+
+/// Finds the root uri of the recorded workspace, as sent by the client in the initialize request
+static std::optional<std::string> findRecordedWorkspaceRoot(const std::vector<RecordedMessage>& session)
+{
+    for (const auto& entry : session)
+    {
+        // Invalid messages are recorded as-is, so are skipped over
+        auto message = json::parse(entry.message, /* cb: */ nullptr, /* allow_exceptions: */ false);
+        if (!message.is_object() || message.value("method", "") != "initialize" || !message.contains("params"))
+            continue;
+
+        const auto& params = message.at("params");
+        if (params.contains("workspaceFolders") && params.at("workspaceFolders").is_array() && !params.at("workspaceFolders").empty())
+            return params.at("workspaceFolders").at(0).at("uri").get<std::string>();
+        if (params.contains("rootUri") && params.at("rootUri").is_string())
+            return params.at("rootUri").get<std::string>();
+        return std::nullopt;
+    }
+
+    return std::nullopt;
+}
+
+struct ResourceUsage
+{
+    double cpuSeconds = 0.0;
+    size_t peakMemoryBytes = 0;
+};
+
+static ResourceUsage getResourceUsage()
+{
+    ResourceUsage usage;
+
+#ifdef _WIN32
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
+    {
+        auto toSeconds = [](const FILETIME& time)
+        {
+            return double((uint64_t(time.dwHighDateTime) << 32) | time.dwLowDateTime) / 1e7;
+        };
+        usage.cpuSeconds = toSeconds(kernelTime) + toSeconds(userTime);
+    }
+
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        usage.peakMemoryBytes = counters.PeakWorkingSetSize;
+#else
+    rusage resourceUsage;
+    if (getrusage(RUSAGE_SELF, &resourceUsage) == 0)
+    {
+        usage.cpuSeconds = double(resourceUsage.ru_utime.tv_sec) + double(resourceUsage.ru_utime.tv_usec) / 1e6 +
+                           double(resourceUsage.ru_stime.tv_sec) + double(resourceUsage.ru_stime.tv_usec) / 1e6;
+#ifdef __APPLE__
+        // macOS reports the maximum resident set size in bytes
+        usage.peakMemoryBytes = size_t(resourceUsage.ru_maxrss);
+#else
+        // Linux reports the maximum resident set size in kilobytes
+        usage.peakMemoryBytes = size_t(resourceUsage.ru_maxrss) * 1024;
+#endif
+    }
+#endif
+
+    return usage;
+}
+
+void replaySession(LanguageServer& server, std::vector<RecordedMessage> session, const ReplayOptions& options)
+{
+    if (options.workspace)
+    {
+        if (auto recordedRoot = findRecordedWorkspaceRoot(session))
+        {
+            auto newRoot = Uri::file(std::filesystem::absolute(*options.workspace)).toString();
+
+            // Strip any trailing slashes so that the remapping is applied consistently to paths within the workspace
+            while (!recordedRoot->empty() && recordedRoot->back() == '/')
+                recordedRoot->pop_back();
+            while (!newRoot.empty() && newRoot.back() == '/')
+                newRoot.pop_back();
+
+            for (auto& entry : session)
+                replaceAll(entry.message, *recordedRoot, newRoot);
+        }
+        else
+        {
+            std::cerr << "Could not find the workspace root in the recorded session, messages will be replayed unmodified\n";
+        }
+    }
+
+    statistics().clear();
+    auto startUsage = getResourceUsage();
+    auto startTime = std::chrono::steady_clock::now();
+
+    size_t messageCount = 0;
+    for (const auto& entry : session)
+    {
+        if (options.realtime)
+            std::this_thread::sleep_until(startTime + std::chrono::duration<double, std::milli>(entry.time));
+
+        // The exit notification terminates the process, so we stop replaying once it is reached
+        if (entry.message.find(R"("exit")") != std::string::npos)
+            if (auto message = json::parse(entry.message, nullptr, false); message.is_object() && message.value("method", "") == "exit")
+                break;
+
+        server.processMessage(entry.message);
+        messageCount++;
+    }
+
+    // Wait for all dispatched requests to complete before reporting
+    server.waitForPendingRequests();
+
+    auto wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    auto endUsage = getResourceUsage();
+
+    std::cout << statistics().toString();
+    std::cout << "\nReplayed " << messageCount << " messages in " << wallTime << "s\n";
+    std::cout << "CPU time: " << (endUsage.cpuSeconds - startUsage.cpuSeconds) << "s\n";
+    std::cout << "Peak memory: " << (endUsage.peakMemoryBytes / (1024 * 1024)) << "MB\n";
+}
@@ -0,0 +1,102 @@
+#include "LSP/RequireGraphCache.hpp"
+
+#include <iomanip>
+#include <sstream>
+
+#include "nlohmann/json.hpp"
+#include "LSP/Utils.hpp"
+
+using json = nlohmann::json;
+
+/// Bumped whenever the format of the cache file changes, so that old cache files are discarded
+static constexpr int CacheVersion = 1;
+
+std::optional<FileStamp> FileStamp::of(const std::filesystem::path& path)
+{
+    std::error_code ec;
+    auto lastWriteTime = std::filesystem::last_write_time(path, ec);
+    if (ec)
+        return std::nullopt;
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec)
+        return std::nullopt;
+
+    return FileStamp{static_cast<int64_t>(lastWriteTime.time_since_epoch().count()), size};
+}
+
+RequireGraphCache::RequireGraphCache(std::string fingerprint)
+    : fingerprint(std::move(fingerprint))
+{
+}
+
+RequireGraphCache RequireGraphCache::load(const std::filesystem::path& path, const std::string& fingerprint)
+{
+    RequireGraphCache cache(fingerprint);
+
+    auto contents = readFile(path);
+    if (!contents)
+        return cache;
+
+    try
+    {
+        auto data = json::parse(*contents);
+        if (data.at("version").get<int>() != CacheVersion || data.at("fingerprint").get<std::string>() != fingerprint)
+            return cache;
+
+        for (auto& [filePath, file] : data.at("files").items())
+        {
+            Entry entry;
+            entry.moduleName = file.at("module").get<std::string>();
+            entry.stamp.lastWriteTime = file.at("mtime").get<int64_t>();
+            entry.stamp.size = file.at("size").get<uintmax_t>();
+            entry.requiredModules = file.at("requires").get<std::vector<std::string>>();
+            cache.entries.emplace(filePath, std::move(entry));
+        }
+    }
+    catch (const std::exception&)
+    {
+        // The cache is malformed, so start afresh
+        cache.entries.clear();
+    }
+
+    return cache;
+}
+
+bool RequireGraphCache::save(const std::filesystem::path& path) const
+{
+    json files = json::object();
+    for (const auto& [filePath, entry] : entries)
+        files[filePath] = {
+            {"module", entry.moduleName},
+            {"mtime", entry.stamp.lastWriteTime},
+            {"size", entry.stamp.size},
+            {"requires", entry.requiredModules},
+        };
+    json data = {{"version", CacheVersion}, {"fingerprint", fingerprint}, {"files", std::move(files)}};
+
+    // Written atomically, so that a concurrently starting server never reads a partially written cache
+    return writeFileAtomically(path, data.dump());
+}
+
+std::filesystem::path RequireGraphCache::pathForWorkspace(const std::filesystem::path& cacheDirectory, const std::string& workspaceUri)
+{
+    // The name must be stable across sessions
+    auto hash = hashString(workspaceUri);
+
+    std::stringstream name;
+    name << "requireGraph-" << std::hex << std::setw(16) << std::setfill('0') << hash << ".json";
+    return cacheDirectory / name.str();
+}
+
+const RequireGraphCache::Entry* RequireGraphCache::find(const std::filesystem::path& filePath, const FileStamp& stamp) const
+{
+    auto it = entries.find(filePath.generic_string());
+    if (it == entries.end() || it->second.stamp != stamp)
+        return nullptr;
+    return &it->second;
+}
+
+void RequireGraphCache::insert(const std::filesystem::path& filePath, Entry entry)
+{
+    entries.insert_or_assign(filePath.generic_string(), std::move(entry));
+}
@@ -0,0 +1,54 @@
+#include "LSP/ReverseDependencyIndex.hpp"
+
+void ReverseDependencyIndex::update(const std::string& moduleName, const std::unordered_set<std::string>& requiredModules)
+{
+    auto& recorded = moduleRequires[moduleName];
+    for (const auto& required : recorded)
+    {
+        if (requiredModules.find(required) != requiredModules.end())
+            continue;
+
+        if (auto it = dependents.find(required); it != dependents.end())
+        {
+            it->second.erase(moduleName);
+            if (it->second.empty())
+                dependents.erase(it);
+        }
+    }
+
+    for (const auto& required : requiredModules)
+        dependents[required].insert(moduleName);
+
+    recorded.assign(requiredModules.begin(), requiredModules.end());
+}
+
+void ReverseDependencyIndex::remove(const std::string& moduleName)
+{
+    update(moduleName, {});
+    moduleRequires.erase(moduleName);
+}
+
+void ReverseDependencyIndex::clear()
+{
+    moduleRequires.clear();
+    dependents.clear();
+}
+
+std::vector<std::string> ReverseDependencyIndex::findTransitiveDependents(const std::string& moduleName) const
+{
+    std::vector<std::string> result{moduleName};
+    std::unordered_set<std::string> visited{moduleName};
+
+    for (size_t i = 0; i < result.size(); i++)
+    {
+        auto it = dependents.find(result[i]);
+        if (it == dependents.end())
+            continue;
+
+        for (const auto& dependent : it->second)
+            if (visited.insert(dependent).second)
+                result.push_back(dependent);
+    }
+
+    return result;
+}
@@ -0,0 +1,148 @@
+#include "LSP/Statistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+size_t LatencyHistogram::bucketIndex(uint64_t micros)
+{
+    // Small values map directly onto a bucket
+    if (micros < SubBucketCount)
+        return size_t(micros);
+
+    size_t exponent = 63;
+    while ((micros >> exponent) == 0)
+        exponent--;
+
+    size_t subBucket = size_t(micros >> (exponent - SubBucketBits)) & (SubBucketCount - 1);
+    return std::min((exponent - SubBucketBits + 1) * SubBucketCount + subBucket, BucketCount - 1);
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index)
+{
+    if (index < SubBucketCount)
+        return uint64_t(index);
+
+    size_t exponent = index / SubBucketCount + SubBucketBits - 1;
+    uint64_t subBucket = index % SubBucketCount;
+    return ((SubBucketCount + subBucket + 1) << (exponent - SubBucketBits)) - 1;
+}
+
+void LatencyHistogram::record(Duration duration)
+{
+    auto micros = uint64_t(std::max(std::chrono::duration_cast<std::chrono::microseconds>(duration).count(), int64_t(0)));
+    buckets[bucketIndex(micros)]++;
+    totalCount++;
+    totalMicros += micros;
+    maxMicros = std::max(maxMicros, micros);
+}
+
+double LatencyHistogram::percentileMs(double percentile) const
+{
+    if (totalCount == 0)
+        return 0.0;
+
+    auto target = size_t(std::ceil(percentile * double(totalCount)));
+    size_t seen = 0;
+    for (size_t i = 0; i < BucketCount; i++)
+    {
+        seen += buckets[i];
+        if (seen >= target && seen > 0)
+            return double(std::min(bucketUpperBound(i), maxMicros)) / 1000.0;
+    }
+
+    return maxMs();
+}
+
+double LatencyHistogram::maxMs() const
+{
+    return double(maxMicros) / 1000.0;
+}
+
+double LatencyHistogram::totalMs() const
+{
+    return double(totalMicros) / 1000.0;
+}
+
+json LatencyHistogram::toJson() const
+{
+    return json{
+        {"count", totalCount},
+        {"p50", percentileMs(0.50)},
+        {"p95", percentileMs(0.95)},
+        {"p99", percentileMs(0.99)},
+        {"max", maxMs()},
+        {"total", totalMs()},
+    };
+}
+
+Statistics::Statistics()
+    : startTime(std::chrono::steady_clock::now())
+{
+}
+
+void Statistics::record(const std::string& category, const std::string& name, LatencyHistogram::Duration duration)
+{
+    std::unique_lock lock(mutex);
+    histograms[category][name].record(duration);
+}
+
+json Statistics::toJson() const
+{
+    std::unique_lock lock(mutex);
+
+    json result{
+        {"uptime", std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count()},
+        {"unit", "ms"},
+    };
+
+    for (const auto& [category, entries] : histograms)
+    {
+        json categoryJson = json::object();
+        for (const auto& [name, histogram] : entries)
+            categoryJson[name] = histogram.toJson();
+        result[category] = categoryJson;
+    }
+
+    return result;
+}
+
+std::string Statistics::toString() const
+{
+    std::unique_lock lock(mutex);
+
+    std::stringstream output;
+    output << std::fixed << std::setprecision(2);
+    output << "Uptime: " << std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() << "s\n";
+
+    for (const auto& [category, entries] : histograms)
+    {
+        output << "\n" << category << " (ms)\n";
+        output << std::left << std::setw(48) << "name" << std::right << std::setw(10) << "count" << std::setw(12) << "p50" << std::setw(12)
+               << "p95" << std::setw(12) << "p99" << std::setw(12) << "max" << std::setw(14) << "total"
+               << "\n";
+
+        for (const auto& [name, histogram] : entries)
+        {
+            output << std::left << std::setw(48) << name << std::right << std::setw(10) << histogram.count() << std::setw(12)
+                   << histogram.percentileMs(0.50) << std::setw(12) << histogram.percentileMs(0.95) << std::setw(12) << histogram.percentileMs(0.99)
+                   << std::setw(12) << histogram.maxMs() << std::setw(14) << histogram.totalMs() << "\n";
+        }
+    }
+
+    return output.str();
+}
+
+void Statistics::clear()
+{
+    std::unique_lock lock(mutex);
+    histograms.clear();
+    startTime = std::chrono::steady_clock::now();
+}
+
+Statistics& statistics()
+{
+    static Statistics instance;
+    return instance;
+}
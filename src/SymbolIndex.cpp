@@ -0,0 +1,213 @@
+#include "LSP/SymbolIndex.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+#include "LSP/Utils.hpp"
+
+static constexpr uint32_t HumpsTrigramFlag = 1u << 31;
+static constexpr uint32_t FirstCharacterFlag = 1u << 30;
+
+static uint32_t trigramAt(const std::string& str, size_t i)
+{
+    return static_cast<uint8_t>(str[i]) | static_cast<uint8_t>(str[i + 1]) << 8 | static_cast<uint8_t>(str[i + 2]) << 16;
+}
+
+std::string SymbolIndex::humps(const std::string& name)
+{
+    std::string result;
+    for (size_t i = 0; i < name.size(); i++)
+    {
+        unsigned char c = name[i];
+        if (!std::isalnum(c))
+            continue;
+
+        unsigned char previous = i > 0 ? name[i - 1] : '_';
+        bool startsWord = !std::isalnum(previous) || (std::isupper(c) && std::islower(previous)) || (std::isdigit(c) && !std::isdigit(previous));
+        if (startsWord)
+            result += static_cast<char>(std::tolower(c));
+    }
+    return result;
+}
+
+void SymbolIndex::update(const std::string& moduleName, std::vector<lsp::WorkspaceSymbol> symbols)
+{
+    remove(moduleName);
+
+    auto& indices = moduleEntries[moduleName];
+    indices.reserve(symbols.size());
+    for (auto& symbol : symbols)
+    {
+        auto lowerName = symbol.name;
+        toLower(lowerName);
+        auto symbolHumps = humps(symbol.name);
+        indices.push_back(entries.size());
+        entries.push_back(Entry{std::move(symbol), std::move(lowerName), std::move(symbolHumps)});
+        insertPostings(entries.size() - 1);
+    }
+}
+
+void SymbolIndex::remove(const std::string& moduleName)
+{
+    auto it = moduleEntries.find(moduleName);
+    if (it == moduleEntries.end())
+        return;
+
+    for (auto index : it->second)
+        entries[index].alive = false;
+    deadEntries += it->second.size();
+    moduleEntries.erase(it);
+
+    if (deadEntries > entries.size() / 2)
+        compact();
+}
+
+void SymbolIndex::clear()
+{
+    entries.clear();
+    deadEntries = 0;
+    moduleEntries.clear();
+    trigrams.clear();
+}
+
+void SymbolIndex::insertPostings(size_t index)
+{
+    const auto& entry = entries[index];
+
+    // A name may contain the same trigram multiple times, but each entry only needs to be posted once
+    auto post = [&](uint32_t trigram)
+    {
+        auto& postings = trigrams[trigram];
+        if (postings.empty() || postings.back() != index)
+            postings.push_back(index);
+    };
+
+    for (size_t i = 0; i + 3 <= entry.lowerName.size(); i++)
+        post(trigramAt(entry.lowerName, i));
+    if (entry.humps.size() >= 3)
+        post(trigramAt(entry.humps, 0) | HumpsTrigramFlag);
+
+    // Short queries are matched against the start of the name and the humps
+    std::vector<uint32_t> firstCharacters;
+    if (!entry.lowerName.empty())
+        firstCharacters.push_back(static_cast<uint8_t>(entry.lowerName[0]) | FirstCharacterFlag);
+    if (!entry.humps.empty())
+        firstCharacters.push_back(static_cast<uint8_t>(entry.humps[0]) | FirstCharacterFlag);
+    for (auto key : firstCharacters)
+        post(key);
+}
+
+void SymbolIndex::compact()
+{
+    std::vector<Entry> liveEntries;
+    liveEntries.reserve(entries.size() - deadEntries);
+
+    std::vector<size_t> remapped(entries.size());
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        if (entries[i].alive)
+        {
+            remapped[i] = liveEntries.size();
+            liveEntries.push_back(std::move(entries[i]));
+        }
+    }
+
+    for (auto& [_, indices] : moduleEntries)
+        for (auto& index : indices)
+            index = remapped[index];
+
+    entries = std::move(liveEntries);
+    deadEntries = 0;
+    trigrams.clear();
+    for (size_t i = 0; i < entries.size(); i++)
+        insertPostings(i);
+}
+
+int SymbolIndex::score(const Entry& entry, const std::string& query)
+{
+    if (query.empty())
+        return 1;
+
+    // Shorter names are preferred amongst matches of the same kind
+    int lengthPenalty = static_cast<int>(std::min(entry.lowerName.size() - std::min(entry.lowerName.size(), query.size()), size_t(99)));
+
+    if (entry.lowerName == query)
+        return 1000;
+    if (entry.lowerName.compare(0, query.size(), query) == 0)
+        return 800 - lengthPenalty;
+    if (entry.humps.compare(0, query.size(), query) == 0)
+        return 600 - lengthPenalty;
+    if (auto position = entry.lowerName.find(query); query.size() >= 3 && position != std::string::npos)
+        return 400 - static_cast<int>(std::min(position, size_t(99))) - lengthPenalty;
+    return 0;
+}
+
+std::vector<lsp::WorkspaceSymbol> SymbolIndex::search(const std::string& originalQuery, size_t limit) const
+{
+    auto query = originalQuery;
+    toLower(query);
+    std::vector<std::pair<int, size_t>> matches;
+
+    auto consider = [&](size_t index)
+    {
+        const auto& entry = entries[index];
+        if (!entry.alive)
+            return;
+        if (int entryScore = score(entry, query); entryScore > 0)
+            matches.emplace_back(entryScore, index);
+    };
+
+    static const std::vector<size_t> noPostings;
+    auto postingsFor = [&](uint32_t key) -> const std::vector<size_t>&
+    {
+        auto it = trigrams.find(key);
+        return it == trigrams.end() ? noPostings : it->second;
+    };
+
+    if (query.empty())
+    {
+        for (size_t i = 0; i < entries.size(); i++)
+            consider(i);
+    }
+    else if (query.size() < 3)
+    {
+        for (auto index : postingsFor(static_cast<uint8_t>(query[0]) | FirstCharacterFlag))
+            consider(index);
+    }
+    else
+    {
+        // Any name containing the query contains all of its trigrams, so only the entries of the rarest trigram need to be checked.
+        // Hump matches are found separately, as the name may not contain any of the query's trigrams
+        const std::vector<size_t>* rarest = nullptr;
+        for (size_t i = 0; i + 3 <= query.size(); i++)
+        {
+            const auto& postings = postingsFor(trigramAt(query, i));
+            if (!rarest || postings.size() < rarest->size())
+                rarest = &postings;
+        }
+
+        const auto& humpPostings = postingsFor(trigramAt(query, 0) | HumpsTrigramFlag);
+
+        std::vector<size_t> candidates;
+        candidates.reserve(rarest->size() + humpPostings.size());
+        std::set_union(rarest->begin(), rarest->end(), humpPostings.begin(), humpPostings.end(), std::back_inserter(candidates));
+        for (auto index : candidates)
+            consider(index);
+    }
+
+    auto byRank = [&](const std::pair<int, size_t>& a, const std::pair<int, size_t>& b)
+    {
+        if (a.first != b.first)
+            return a.first > b.first;
+        return entries[a.second].symbol.name < entries[b.second].symbol.name;
+    };
+
+    auto end = matches.begin() + static_cast<ptrdiff_t>(std::min(limit, matches.size()));
+    std::partial_sort(matches.begin(), end, matches.end(), byRank);
+
+    std::vector<lsp::WorkspaceSymbol> result;
+    result.reserve(static_cast<size_t>(end - matches.begin()));
+    for (auto it = matches.begin(); it != end; ++it)
+        result.push_back(entries[it->second].symbol);
+    return result;
+}
@@ -102,6 +102,26 @@ std::optional<std::string> readFile(const std::filesystem::path& filePath)
     }
 }
 
+bool writeFileAtomically(const std::filesystem::path& filePath, const std::string& contents)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(filePath.parent_path(), ec);
+
+    auto temporaryPath = filePath;
+    temporaryPath += ".tmp";
+    {
+        std::ofstream output(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!output)
+            return false;
+        output << contents;
+        if (!output)
+            return false;
+    }
+
+    std::filesystem::rename(temporaryPath, filePath, ec);
+    return !ec;
+}
+
 std::optional<std::filesystem::path> getHomeDirectory()
 {
     if (const char* home = getenv("HOME"))
@@ -185,4 +205,13 @@ void replaceAll(std::string& str, const std::string& from, const std::string& to
         str.replace(start_pos, from.length(), to);
         start_pos += to.length();
     }
-}
\ No newline at end of file
+}
+uint64_t hashString(std::string_view str, uint64_t hash)
+{
+    for (unsigned char c : str)
+    {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
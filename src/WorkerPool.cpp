@@ -0,0 +1,114 @@
+#include "LSP/WorkerPool.hpp"
+
+#include <algorithm>
+
+WorkerPool::WorkerPool(size_t threadCount)
+{
+    threadCount = std::max(threadCount, size_t(1));
+    workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; i++)
+        workers.emplace_back(&WorkerPool::workerLoop, this);
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::unique_lock lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+
+    for (auto& worker : workers)
+        worker.join();
+}
+
+void WorkerPool::push(Task task, TaskPriority priority)
+{
+    {
+        std::unique_lock lock(mutex);
+        tasks[static_cast<size_t>(priority)].push(std::move(task));
+    }
+    condition.notify_one();
+}
+
+void WorkerPool::pushAfter(std::chrono::steady_clock::duration delay, Task task, TaskPriority priority)
+{
+    {
+        std::unique_lock lock(mutex);
+        delayedTasks.emplace(std::chrono::steady_clock::now() + delay, std::make_pair(priority, std::move(task)));
+    }
+    // Wake a worker so that it can wait for the new deadline, in case it is earlier than the current one
+    condition.notify_one();
+}
+
+size_t WorkerPool::defaultThreadCount()
+{
+    // hardware_concurrency may return 0 if it is not computable
+    return std::max(std::thread::hardware_concurrency(), 2u);
+}
+
+void WorkerPool::workerLoop()
+{
+    while (true)
+    {
+        Task task;
+
+        {
+            std::unique_lock lock(mutex);
+            auto hasTasks = [this]()
+            {
+                return std::any_of(tasks.begin(), tasks.end(),
+                    [](const auto& queue)
+                    {
+                        return !queue.empty();
+                    });
+            };
+
+            while (true)
+            {
+                // Move any delayed tasks which are now due into the queues
+                auto now = std::chrono::steady_clock::now();
+                while (!delayedTasks.empty() && delayedTasks.begin()->first <= now)
+                {
+                    auto& [priority, delayedTask] = delayedTasks.begin()->second;
+                    tasks[static_cast<size_t>(priority)].push(std::move(delayedTask));
+                    delayedTasks.erase(delayedTasks.begin());
+                }
+
+                // Background and delayed work is abandoned when stopping, but any other remaining tasks are drained
+                if (stopping)
+                {
+                    tasks[static_cast<size_t>(TaskPriority::Background)] = {};
+                    delayedTasks.clear();
+                }
+
+                if (hasTasks())
+                    break;
+                if (stopping)
+                    return;
+
+                if (delayedTasks.empty())
+                    condition.wait(lock);
+                else
+                    condition.wait_until(lock, delayedTasks.begin()->first);
+            }
+
+            // Take the task with the highest priority
+            for (auto& queue : tasks)
+            {
+                if (!queue.empty())
+                {
+                    task = std::move(queue.front());
+                    queue.pop();
+                    break;
+                }
+            }
+
+            // Several delayed tasks may have become due at once, so make sure another worker picks up the rest
+            if (hasTasks())
+                condition.notify_one();
+        }
+
+        task();
+    }
+}
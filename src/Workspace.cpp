@@ -1,11 +1,17 @@
 #include "LSP/Workspace.hpp"
 
 #include <iostream>
+#include <algorithm>
+#include <chrono>
 #include <climits>
+#include <unordered_set>
 
-#include "glob/glob.hpp"
 #include "Luau/BuiltinDefinitions.h"
 #include "LSP/LuauExt.hpp"
+#include "LSP/Statistics.hpp"
+#include "LSP/WorkerPool.hpp"
+#include "LSP/Utils.hpp"
+#include "LSP/RequireGraphCache.hpp"
 
 void WorkspaceFolder::openTextDocument(const lsp::DocumentUri& uri, const lsp::DidOpenTextDocumentParams& params)
 {
@@ -16,7 +22,7 @@ void WorkspaceFolder::openTextDocument(const lsp::DocumentUri& uri, const lsp::D
 
     // Mark the file as dirty as we don't know what changes were made to it
     auto moduleName = fileResolver.getModuleName(uri);
-    frontend.markDirty(moduleName);
+    markDirty(moduleName);
 }
 
 void WorkspaceFolder::updateTextDocument(
@@ -34,7 +40,7 @@ void WorkspaceFolder::updateTextDocument(
 
     // Mark the module dirty for the typechecker
     auto moduleName = fileResolver.getModuleName(uri);
-    frontend.markDirty(moduleName, markedDirty);
+    markDirty(moduleName, markedDirty);
 }
 
 void WorkspaceFolder::closeTextDocument(const lsp::DocumentUri& uri)
@@ -44,26 +50,37 @@ void WorkspaceFolder::closeTextDocument(const lsp::DocumentUri& uri)
     // Mark the module as dirty as we no longer track its changes
     auto config = client->getConfiguration(rootUri);
     auto moduleName = fileResolver.getModuleName(uri);
-    frontend.markDirty(moduleName);
+    markDirty(moduleName);
 
     // Refresh workspace diagnostics to clear diagnostics on ignored files
-    if (!config.diagnostics.workspace || isIgnoredFile(uri.fsPath()))
+    if (!config->diagnostics.workspace || isIgnoredFile(uri.fsPath(), *config))
         clearDiagnosticsForFile(uri);
 }
 
+void WorkspaceFolder::markDirty(const Luau::ModuleName& moduleName, std::vector<Luau::ModuleName>* markedDirty)
+{
+    std::vector<Luau::ModuleName> dirtied{};
+    frontend.markDirty(moduleName, &dirtied);
+    for (const auto& name : dirtied)
+        pendingReverseDependencyUpdates.try_emplace(name);
+
+    if (markedDirty)
+        markedDirty->insert(markedDirty->end(), dirtied.begin(), dirtied.end());
+}
+
 void WorkspaceFolder::clearDiagnosticsForFile(const lsp::DocumentUri& uri)
 {
     if (!client->capabilities.textDocument || !client->capabilities.textDocument->diagnostic)
     {
         client->publishDiagnostics(lsp::PublishDiagnosticsParams{uri, std::nullopt, {}});
     }
-    else if (client->workspaceDiagnosticsToken)
+    else if (auto workspaceDiagnosticsToken = client->getWorkspaceDiagnosticsToken())
     {
         lsp::WorkspaceDocumentDiagnosticReport documentReport;
         documentReport.uri = uri;
         documentReport.kind = lsp::DocumentDiagnosticReportKind::Full;
         lsp::WorkspaceDiagnosticReportPartialResult report{{documentReport}};
-        client->sendProgress({client->workspaceDiagnosticsToken.value(), report});
+        client->sendProgress({workspaceDiagnosticsToken.value(), report});
     }
     else
     {
@@ -71,49 +88,122 @@ void WorkspaceFolder::clearDiagnosticsForFile(const lsp::DocumentUri& uri)
     }
 }
 
+/// The compiled `ignoreGlobs` of the configuration snapshot.
+/// Configurations which were not created as a snapshot (e.g. those constructed directly in tests) have the globs compiled on demand
+static std::shared_ptr<const GlobMatcher> getIgnoreGlobMatcher(const ClientConfiguration& config)
+{
+    if (config.ignoreGlobMatcher)
+        return config.ignoreGlobMatcher;
+    return std::make_shared<const GlobMatcher>(config.ignoreGlobs);
+}
+
 /// Whether the file has been marked as ignored by any of the ignored lists in the configuration
-bool WorkspaceFolder::isIgnoredFile(const std::filesystem::path& path, const std::optional<ClientConfiguration>& givenConfig)
+bool WorkspaceFolder::isIgnoredFile(const std::filesystem::path& path)
+{
+    return isIgnoredFile(path, *client->getConfiguration(rootUri));
+}
+
+bool WorkspaceFolder::isIgnoredFile(const std::filesystem::path& path, const ClientConfiguration& config)
 {
     // We want to test globs against a relative path to workspace, since thats what makes most sense
     auto relativePath = path.lexically_relative(rootUri.fsPath()).generic_string(); // HACK: we convert to generic string so we get '/' separators
 
-    auto config = givenConfig ? *givenConfig : client->getConfiguration(rootUri);
-    std::vector<std::string> patterns = config.ignoreGlobs; // TODO: extend further?
-    for (auto& pattern : patterns)
+    return getIgnoreGlobMatcher(config)->matches(relativePath);
+}
+
+bool WorkspaceFolder::isDefinitionFile(const std::filesystem::path& path)
+{
+    return isDefinitionFile(path, *client->getConfiguration(rootUri));
+}
+
+bool WorkspaceFolder::isDefinitionFile(const std::filesystem::path& path, const ClientConfiguration& config)
+{
+    auto canonicalised = fileResolver.canonicalPath(path).generic_string();
+
+    // See `getIgnoreGlobMatcher`: configurations which were not created as a snapshot are canonicalised on demand
+    if (!config.ignoreGlobMatcher)
     {
-        if (glob::fnmatch_case(relativePath, pattern))
-        {
-            return true;
-        }
+        for (const auto& file : config.types.definitionFiles)
+            if (fileResolver.canonicalPath(file).generic_string() == canonicalised)
+                return true;
+        return false;
     }
-    return false;
+
+    return config.canonicalDefinitionFiles.find(canonicalised) != config.canonicalDefinitionFiles.end();
 }
 
-bool WorkspaceFolder::isDefinitionFile(const std::filesystem::path& path, const std::optional<ClientConfiguration>& givenConfig)
+bool WorkspaceFolder::isWithinExcludedDirectory(const std::filesystem::path& path, const ClientConfiguration& config)
 {
-    auto config = givenConfig ? *givenConfig : client->getConfiguration(rootUri);
-    auto canonicalised = std::filesystem::weakly_canonical(path);
+    auto relativePath = path.lexically_relative(rootUri.fsPath());
+    if (relativePath.empty() || *relativePath.begin() == "..")
+        return true;
 
-    for (auto& file : config.types.definitionFiles)
+    for (const auto& part : relativePath)
     {
-        if (std::filesystem::weakly_canonical(file) == canonicalised)
-        {
+        auto name = part.generic_string();
+        if (name.size() > 1 && name[0] == '.' && name != "..")
             return true;
-        }
     }
 
-    return false;
+    return getIgnoreGlobMatcher(config)->matchesEntireDirectory(relativePath.generic_string());
+}
+
+std::vector<std::filesystem::path> WorkspaceFolder::findSourceFiles(const ClientConfiguration& config, bool includeIgnored)
+{
+    // Without file watchers, we will not be told about created or deleted files, so we must walk the workspace every time
+    bool watchingFiles = client->capabilities.workspace && client->capabilities.workspace->didChangeWatchedFiles &&
+                         client->capabilities.workspace->didChangeWatchedFiles->dynamicRegistration;
+    auto matcher = getIgnoreGlobMatcher(config);
+    if (!fileInventory.isBuilt() || !watchingFiles || fileInventoryIgnoreGlobs != config.ignoreGlobs)
+    {
+        fileInventoryIgnoreGlobs = config.ignoreGlobs;
+
+        // Directories in which every file is ignored are skipped entirely
+        auto root = rootUri.fsPath();
+        fileInventory.build(
+            [matcher, root](const std::filesystem::path& directory)
+            {
+                return matcher->matchesEntireDirectory(directory.lexically_relative(root).generic_string());
+            });
+    }
+
+    // Files are only reclassified if the relevant configuration changes
+    auto classificationKey = json{{"ignoreGlobs", config.ignoreGlobs}, {"definitionFiles", config.types.definitionFiles}}.dump();
+    const auto& entries = fileInventory.entries(classificationKey,
+        [&](const std::filesystem::path& path)
+        {
+            auto relativePath = path.lexically_relative(rootUri.fsPath()).generic_string();
+            return FileInventory::Classification{isDefinitionFile(path, config), matcher->matches(relativePath)};
+        });
+
+    std::vector<std::filesystem::path> files;
+    files.reserve(entries.size());
+    for (const auto& entry : entries)
+        if (!entry.classification.definitionFile && (includeIgnored || !entry.classification.ignored))
+            files.push_back(entry.path);
+
+    return files;
 }
 
 // Runs `Frontend::check` on the module and DISCARDS THE TYPE GRAPH.
 // Uses the diagnostic type checker, so strictness and DM awareness is not enforced
 // NOTE: do NOT use this if you later retrieve a ModulePtr (via frontend.moduleResolver.getModule). Instead use `checkStrict`
 // NOTE: use `frontend.parse` if you do not care about typechecking
-Luau::CheckResult WorkspaceFolder::checkSimple(const Luau::ModuleName& moduleName, bool runLintChecks)
+// Throws a RequestCancelledException if cancellation is requested before or during the check.
+Luau::CheckResult WorkspaceFolder::checkSimple(const Luau::ModuleName& moduleName, bool runLintChecks, const LSPCancellationToken& cancellationToken)
 {
+    throwIfCancelled(cancellationToken);
+
     try
     {
-        return frontend.check(moduleName, Luau::FrontendOptions{/* retainFullTypeGraphs: */ false, /* forAutocomplete: */ false, runLintChecks});
+        Luau::CheckResult result;
+        {
+            ScopedTimer timer(Statistics::Frontend, "check");
+            result =
+                frontend.check(moduleName, Luau::FrontendOptions{/* retainFullTypeGraphs: */ false, /* forAutocomplete: */ false, runLintChecks});
+        }
+        throwIfCancelled(cancellationToken);
+        return result;
     }
     catch (Luau::InternalCompilerError& err)
     {
@@ -125,21 +215,167 @@ Luau::CheckResult WorkspaceFolder::checkSimple(const Luau::ModuleName& moduleNam
     }
 }
 
+// Throws a RequestCancelledException if cancellation is requested before, during or after the check.
+void WorkspaceFolder::checkSimpleInParallel(
+    const std::vector<Luau::ModuleName>& moduleNames, bool runLintChecks, const LSPCancellationToken& cancellationToken)
+{
+    throwIfCancelled(cancellationToken);
+
+    // The pool is kept for the lifetime of the workspace, rather than spawning and joining its threads for every call
+    if (!checkPool)
+        checkPool = std::make_unique<WorkerPool>();
+
+    // The Frontend waits on every task it hands out, so a task cannot be skipped once it has been queued.
+    // Instead, the modules are checked in waves, and cancellation is checked in between them
+    // (any requires of a wave which are still dirty are checked alongside it)
+    const size_t waveSize = 4 * WorkerPool::defaultThreadCount();
+    for (size_t waveStart = 0; waveStart < moduleNames.size(); waveStart += waveSize)
+    {
+        std::vector<Luau::ModuleName> wave(
+            moduleNames.begin() + waveStart, moduleNames.begin() + std::min(waveStart + waveSize, moduleNames.size()));
+        try
+        {
+            ScopedTimer timer(Statistics::Frontend, "checkParallel");
+            frontend.queueModuleCheck(wave);
+            frontend.checkQueuedModules(Luau::FrontendOptions{/* retainFullTypeGraphs: */ false, /* forAutocomplete: */ false, runLintChecks},
+                [this](std::function<void()> task)
+                {
+                    checkPool->push(std::move(task));
+                });
+        }
+        catch (Luau::InternalCompilerError& err)
+        {
+            // Any modules left unchecked are still dirty, and will be picked up by the next `checkSimple`
+            client->sendLogMessage(
+                lsp::MessageType::Warning, std::string("Luau InternalCompilerError caught whilst checking modules: ") + err.what());
+        }
+
+        throwIfCancelled(cancellationToken);
+    }
+}
+
 // Runs `Frontend::check` on the module whilst retaining the type graph.
 // Uses the autocomplete typechecker to enforce strictness and DM awareness.
 // NOTE: a disadvantage of the autocomplete typechecker is that it has a timeout restriction that
 // can often be hit
-void WorkspaceFolder::checkStrict(const Luau::ModuleName& moduleName, bool forAutocomplete)
+// Throws a RequestCancelledException if cancellation is requested before or during the check.
+void WorkspaceFolder::checkStrict(const Luau::ModuleName& moduleName, bool forAutocomplete, const LSPCancellationToken& cancellationToken)
 {
+    throwIfCancelled(cancellationToken);
+
     // HACK: note that a previous call to `Frontend::check(moduleName, { retainTypeGraphs: false })`
     // and then a call `Frontend::check(moduleName, { retainTypeGraphs: true })` will NOT actually
     // retain the type graph if the module is not marked dirty.
     // We do a manual check and dirty marking to fix this
     auto module = forAutocomplete ? frontend.moduleResolverForAutocomplete.getModule(moduleName) : frontend.moduleResolver.getModule(moduleName);
     if (module && module->internalTypes.types.empty()) // If we didn't retain type graphs, then the internalTypes arena is empty
-        frontend.markDirty(moduleName);
+        markDirty(moduleName);
 
-    frontend.check(moduleName, Luau::FrontendOptions{/* retainFullTypeGraphs: */ true, forAutocomplete, /* runLintChecks: */ false});
+    {
+        ScopedTimer timer(Statistics::Frontend, "check");
+        frontend.check(moduleName, Luau::FrontendOptions{/* retainFullTypeGraphs: */ true, forAutocomplete, /* runLintChecks: */ false});
+    }
+    throwIfCancelled(cancellationToken);
+}
+
+// Parses the module (if it is dirty) and returns its source module, or nullptr if it could not be found.
+// This does not run the typechecker, so it is safe to use from read-only requests holding a shared workspace lock.
+// NOTE: the returned source module is only valid until the next document mutation
+Luau::SourceModule* WorkspaceFolder::parseSourceModule(const Luau::ModuleName& moduleName)
+{
+    std::unique_lock lock(parseMutex);
+    {
+        ScopedTimer timer(Statistics::Frontend, "parse");
+        frontend.parse(moduleName);
+    }
+    return frontend.getSourceModule(moduleName);
+}
+
+std::vector<Luau::ModuleName> WorkspaceFolder::findRequireClosure(const Luau::ModuleName& moduleName)
+{
+    // Parsing a module also parses all of its transitive requires
+    parseSourceModule(moduleName);
+
+    // Post-order traversal of the require graph, done iteratively so that long require chains do not overflow the stack
+    std::vector<Luau::ModuleName> closure;
+    std::unordered_set<Luau::ModuleName> visited;
+    std::vector<std::pair<Luau::ModuleName, bool>> stack{{moduleName, false}};
+    while (!stack.empty())
+    {
+        auto [name, expanded] = std::move(stack.back());
+        stack.pop_back();
+
+        if (expanded)
+        {
+            closure.push_back(std::move(name));
+            continue;
+        }
+
+        if (!visited.insert(name).second)
+            continue;
+
+        stack.emplace_back(name, true);
+        if (auto it = frontend.sourceNodes.find(name); it != frontend.sourceNodes.end())
+            for (const auto& dependency : it->second->requireSet)
+                if (visited.find(dependency) == visited.end())
+                    stack.emplace_back(dependency, false);
+    }
+
+    return closure;
+}
+
+std::vector<Luau::ModuleName> WorkspaceFolder::findUncheckedRequireClosure(const Luau::ModuleName& moduleName)
+{
+    auto closure = findRequireClosure(moduleName);
+    closure.erase(std::remove_if(closure.begin(), closure.end(),
+                      [&](const Luau::ModuleName& name)
+                      {
+                          // See the note in `checkStrict`: a module checked without retaining type graphs has an empty internalTypes arena
+                          auto module = frontend.moduleResolverForAutocomplete.getModule(name);
+                          return module && !module->internalTypes.types.empty() && !frontend.isDirty(name, /* forAutocomplete: */ true);
+                      }),
+        closure.end());
+    return closure;
+}
+
+std::string WorkspaceFolder::requireGraphFingerprint(const ClientConfiguration& config)
+{
+    json fingerprint = {{"require", config.require}, {"sourcemap", config.sourcemap.enabled}};
+    if (config.sourcemap.enabled)
+        if (auto stamp = FileStamp::of(rootUri.fsPath() / "sourcemap.json"))
+            fingerprint["sourcemapStamp"] = {stamp->lastWriteTime, stamp->size};
+    return fingerprint.dump();
+}
+
+/// Whether the string requires of a cached module still resolve to the same files. These are resolved against the files present on disk
+/// (`./module` resolves to `module/init.luau`, then `module.luau`, then `module.lua`), so they can change even if the module itself has not.
+/// Requires of files outside of the source files (e.g. ignored files) are treated as changed
+static bool hasUnchangedFileRequires(
+    const RequireGraphCache::Entry& entry, const std::unordered_set<std::string>& sourceFiles, const WorkspaceFileResolver& fileResolver)
+{
+    auto exists = [&](const std::filesystem::path& path)
+    {
+        return sourceFiles.find(path.generic_string()) != sourceFiles.end();
+    };
+
+    for (const auto& requiredModule : entry.requiredModules)
+    {
+        if (fileResolver.isVirtualPath(requiredModule))
+            continue;
+
+        std::filesystem::path path(requiredModule);
+        if (!exists(path))
+            return false;
+
+        // A file which takes precedence over the resolved one may have been created since
+        auto base = path.parent_path() / path.stem();
+        if (path.extension() == ".lua" && exists(std::filesystem::path(base).replace_extension(".luau")))
+            return false;
+        if (path.stem() != "init" && (exists(base / "init.luau") || exists(base / "init.lua")))
+            return false;
+    }
+
+    return true;
 }
 
 void WorkspaceFolder::indexFiles(const ClientConfiguration& config)
@@ -150,34 +386,132 @@ void WorkspaceFolder::indexFiles(const ClientConfiguration& config)
     if (isNullWorkspace())
         return;
 
-    size_t indexCount = 0;
+    auto startTime = std::chrono::steady_clock::now();
+
+    // Files which have not changed since the last session have their requires restored from the cache, rather than being parsed
+    std::optional<std::filesystem::path> cachePath = std::nullopt;
+    if (client->cacheDirectory)
+        cachePath = RequireGraphCache::pathForWorkspace(*client->cacheDirectory, rootUri.toString());
+    auto fingerprint = requireGraphFingerprint(config);
+    auto previousCache = cachePath ? RequireGraphCache::load(*cachePath, fingerprint) : RequireGraphCache(fingerprint);
+    RequireGraphCache nextCache(fingerprint);
+
+    auto candidates = findSourceFiles(config);
+
+    // Normalised in the same way as the module names of string requires
+    std::unordered_set<std::string> sourceFiles;
+    sourceFiles.reserve(candidates.size());
+    for (const auto& path : candidates)
+        sourceFiles.insert(Uri::parse(Uri::file(path).toString()).fsPath().generic_string());
 
-    for (std::filesystem::recursive_directory_iterator next(rootUri.fsPath()), end; next != end; ++next)
+    struct IndexedFile
     {
-        if (indexCount >= config.index.maxFiles)
+        std::optional<FileStamp> stamp = std::nullopt;
+        /// Present if the file has not changed since it was cached
+        const RequireGraphCache::Entry* cached = nullptr;
+        std::optional<std::string> source = std::nullopt;
+    };
+
+    // Reading the files in is spread across multiple threads.
+    // The Frontend is not thread-safe, so the files are then parsed here in their original order.
+    // Files are handled in batches so that we do not read in much more than the index limit
+    constexpr size_t batchSize = 512;
+    size_t indexCount = 0;
+    size_t restoredCount = 0;
+    bool limitHit = false;
+    for (size_t batchStart = 0; batchStart < candidates.size() && !limitHit; batchStart += batchSize)
+    {
+        auto batchEnd = std::min(batchStart + batchSize, candidates.size());
+        std::vector<IndexedFile> files(batchEnd - batchStart);
+
         {
-            client->sendWindowMessage(lsp::MessageType::Warning, "The maximum workspace index limit (" + std::to_string(config.index.maxFiles) +
-                                                                     ") has been hit. This may cause some language features to only work partially "
-                                                                     "(Find All References, Rename). If necessary, consider increasing the limit");
-            break;
+            // The pool executes all the queued tasks before it is destroyed
+            WorkerPool pool;
+            for (size_t i = batchStart; i < batchEnd; i++)
+                pool.push(
+                    [&, i]()
+                    {
+                        const auto& path = candidates[i];
+                        auto& file = files[i - batchStart];
+                        file.stamp = FileStamp::of(path);
+                        if (file.stamp)
+                            file.cached = previousCache.find(path, *file.stamp);
+                        if (!file.cached)
+                            file.source = readFile(path);
+                    });
         }
 
-        if (next->is_regular_file() && next->path().has_extension() && !isDefinitionFile(next->path(), config) &&
-            !isIgnoredFile(next->path(), config))
+        for (size_t i = batchStart; i < batchEnd; i++)
         {
-            auto ext = next->path().extension();
-            if (ext == ".lua" || ext == ".luau")
+            const auto& path = candidates[i];
+            auto& file = files[i - batchStart];
+            if (!file.cached && !file.source)
+                continue;
+
+            if (indexCount >= config.index.maxFiles)
             {
-                auto moduleName = fileResolver.getModuleName(Uri::file(next->path()));
+                client->sendWindowMessage(lsp::MessageType::Warning,
+                    "The maximum workspace index limit (" + std::to_string(config.index.maxFiles) +
+                        ") has been hit. This may cause some language features to only work partially "
+                        "(Find All References, Rename). If necessary, consider increasing the limit");
+                limitHit = true;
+                break;
+            }
+
+            auto moduleName = fileResolver.getModuleName(Uri::file(path));
+            indexCount += 1;
+
+            if (file.cached && file.cached->moduleName == moduleName && hasUnchangedFileRequires(*file.cached, sourceFiles, fileResolver))
+            {
+                // The module may have already been parsed as a dependency of an earlier file
+                if (frontend.sourceNodes.find(moduleName) == frontend.sourceNodes.end())
+                {
+                    // The source module is left dirty, so that it is parsed as normal once it is needed
+                    auto sourceNode = std::make_shared<Luau::SourceNode>();
+                    sourceNode->name = moduleName;
+                    sourceNode->humanReadableName = fileResolver.getHumanReadableModuleName(moduleName);
+                    sourceNode->requireSet.insert(file.cached->requiredModules.begin(), file.cached->requiredModules.end());
+                    frontend.sourceNodes.emplace(moduleName, std::move(sourceNode));
+                }
+
+                nextCache.insert(path, *file.cached);
+                restoredCount += 1;
+                continue;
+            }
+
+            // The file was cached under a different module name, or its requires may now resolve differently, so we did not read it in
+            if (!file.source)
+                file.source = readFile(path);
+            if (!file.source)
+                continue;
+            fileResolver.preloadedSources.emplace(moduleName, std::move(*file.source));
 
-                // Parse the module to infer require data
-                // We do not perform any type checking here
+            // Parse the module to infer require data
+            // We do not perform any type checking here
+            {
+                ScopedTimer timer(Statistics::Frontend, "parse");
                 frontend.parse(moduleName);
+            }
 
-                indexCount += 1;
+            if (auto sourceNode = frontend.sourceNodes.find(moduleName); file.stamp && sourceNode != frontend.sourceNodes.end())
+            {
+                std::vector<std::string> requiredModules(sourceNode->second->requireSet.begin(), sourceNode->second->requireSet.end());
+                std::sort(requiredModules.begin(), requiredModules.end());
+                nextCache.insert(path, RequireGraphCache::Entry{moduleName, *file.stamp, std::move(requiredModules)});
             }
         }
     }
+
+    // Modules which were already parsed (e.g. as a dependency of an earlier file) never consume their preloaded source.
+    // Drop them, so that a later read does not pick up stale contents
+    fileResolver.preloadedSources.clear();
+
+    if (cachePath && !nextCache.save(*cachePath))
+        client->sendLogMessage(lsp::MessageType::Warning, "Failed to write require graph cache to " + cachePath->generic_string());
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+    client->sendLogMessage(lsp::MessageType::Info, "Indexed " + std::to_string(indexCount) + " files (" + std::to_string(restoredCount) +
+                                                       " restored from cache) in " + std::to_string(elapsed.count()) + "ms");
 }
 
 bool WorkspaceFolder::updateSourceMap()
@@ -190,6 +524,14 @@ bool WorkspaceFolder::updateSourceMap()
     if (auto sourceMapContents = readFile(sourcemapPath))
     {
         frontend.clear();
+        reverseDependencies.clear();
+        pendingReverseDependencyUpdates.clear();
+        symbolIndex.clear();
+        indexedSymbolModules.clear();
+        referenceIndex.clear();
+        indexedReferenceModules.clear();
+        callGraphIndex.clear();
+        indexedCallGraphModules.clear();
         fileResolver.updateSourceMap(sourceMapContents.value());
 
         // Recreate instance types
@@ -199,9 +541,9 @@ bool WorkspaceFolder::updateSourceMap()
         // We pass the same setting even when we are registering autocomplete globals since
         // the setting impacts what happens to diagnostics (as both calls overwrite frontend.prepareModuleScope)
         types::registerInstanceTypes(frontend, frontend.globals, instanceTypes, fileResolver,
-            /* expressiveTypes: */ config.diagnostics.strictDatamodelTypes);
+            /* expressiveTypes: */ config->diagnostics.strictDatamodelTypes);
         types::registerInstanceTypes(frontend, frontend.globalsForAutocomplete, instanceTypes, fileResolver,
-            /* expressiveTypes: */ config.diagnostics.strictDatamodelTypes);
+            /* expressiveTypes: */ config->diagnostics.strictDatamodelTypes);
 
         return true;
     }
@@ -218,16 +560,15 @@ void WorkspaceFolder::initialize()
 
     Luau::attachTag(Luau::getGlobalBinding(frontend.globalsForAutocomplete, "require"), "Require");
 
-    if (client->definitionsFiles.empty())
+    if (client->definitions.empty())
     {
         client->sendLogMessage(lsp::MessageType::Warning, "No definitions file provided by client");
     }
 
-    for (const auto& definitionsFile : client->definitionsFiles)
+    for (const auto& [definitionsFile, definitionsContents] : client->definitions.files)
     {
         client->sendLogMessage(lsp::MessageType::Info, "Loading definitions file: " + definitionsFile.generic_string());
 
-        auto definitionsContents = readFile(definitionsFile);
         if (!definitionsContents)
         {
             client->sendWindowMessage(lsp::MessageType::Error,
@@ -235,6 +576,8 @@ void WorkspaceFolder::initialize()
             continue;
         }
 
+        // NOTE: only the contents are shared through the snapshot. The definitions are still parsed and checked into each
+        // global environment, as the checked types live in the arenas of the environment they were registered into
         auto result = types::registerDefinitions(frontend, frontend.globals, *definitionsContents, /* typeCheckForAutocomplete = */ false);
         types::registerDefinitions(frontend, frontend.globalsForAutocomplete, *definitionsContents, /* typeCheckForAutocomplete = */ true);
 
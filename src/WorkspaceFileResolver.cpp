@@ -75,13 +75,28 @@ std::optional<SourceNodePtr> WorkspaceFileResolver::getSourceNodeFromVirtualPath
     return virtualPathsToSourceNodes.at(name);
 }
 
-std::optional<SourceNodePtr> WorkspaceFileResolver::getSourceNodeFromRealPath(const std::string& name) const
+std::filesystem::path WorkspaceFileResolver::canonicalPath(const std::filesystem::path& path) const
 {
+    auto key = path.generic_string();
+    {
+        std::lock_guard guard(canonicalPathsMutex);
+        if (auto it = canonicalPaths.find(key); it != canonicalPaths.end())
+            return it->second;
+    }
+
     std::error_code ec;
-    auto canonicalName = std::filesystem::weakly_canonical(name, ec);
+    auto canonicalName = std::filesystem::weakly_canonical(path, ec);
     if (ec.value() != 0)
-        canonicalName = name;
-    auto strName = canonicalName.generic_string();
+        canonicalName = path;
+
+    std::lock_guard guard(canonicalPathsMutex);
+    canonicalPaths.emplace(key, canonicalName);
+    return canonicalName;
+}
+
+std::optional<SourceNodePtr> WorkspaceFileResolver::getSourceNodeFromRealPath(const std::string& name) const
+{
+    auto strName = canonicalPath(name).generic_string();
     if (realPathsToSourceNodes.find(strName) == realPathsToSourceNodes.end())
         return std::nullopt;
     return realPathsToSourceNodes.at(strName);
@@ -161,6 +176,11 @@ std::optional<Luau::SourceCode> WorkspaceFileResolver::readSource(const Luau::Mo
     {
         source = textDocument->getText();
     }
+    else if (auto preloaded = preloadedSources.find(name); preloaded != preloadedSources.end())
+    {
+        source = std::move(preloaded->second);
+        preloadedSources.erase(preloaded);
+    }
     else
     {
         source = readFile(realFileName);
@@ -205,7 +225,7 @@ std::filesystem::path WorkspaceFileResolver::getRequireBasePath(std::optional<Lu
         return rootUri.fsPath();
 
     auto config = client->getConfiguration(rootUri);
-    switch (config.require.mode)
+    switch (config->require.mode)
     {
     case RequireModeConfig::RelativeToWorkspaceRoot:
         return rootUri.fsPath();
@@ -271,12 +291,12 @@ std::optional<Luau::ModuleInfo> WorkspaceFileResolver::resolveModule(const Luau:
             auto config = client->getConfiguration(rootUri);
 
             // Check file aliases
-            if (auto it = config.require.fileAliases.find(requiredString); it != config.require.fileAliases.end())
+            if (auto it = config->require.fileAliases.find(requiredString); it != config->require.fileAliases.end())
             {
                 filePath = resolvePath(it->second);
             }
             // Check directory aliases
-            else if (auto aliasedPath = resolveDirectoryAlias(config.require.directoryAliases, requiredString))
+            else if (auto aliasedPath = resolveDirectoryAlias(config->require.directoryAliases, requiredString))
             {
                 filePath = aliasedPath.value();
             }
@@ -392,6 +412,7 @@ const Luau::Config& WorkspaceFileResolver::getConfig(const Luau::ModuleName& nam
     if (!realPath || !realPath->has_relative_path() || !realPath->has_parent_path())
         return defaultConfig;
 
+    std::unique_lock lock(configCacheMutex);
     return readConfigRec(realPath->parent_path());
 }
 
@@ -435,6 +456,7 @@ const Luau::Config& WorkspaceFileResolver::readConfigRec(const std::filesystem::
 
 void WorkspaceFileResolver::clearConfigCache()
 {
+    std::unique_lock lock(configCacheMutex);
     configCache.clear();
 }
 
@@ -445,11 +467,7 @@ void WorkspaceFileResolver::writePathsToMap(const SourceNodePtr& node, const std
 
     if (auto realPath = node->getScriptFilePath())
     {
-        std::error_code ec;
-        auto canonicalName = std::filesystem::weakly_canonical(rootUri.fsPath() / *realPath, ec);
-        if (ec.value() != 0)
-            canonicalName = *realPath;
-        realPathsToSourceNodes[canonicalName.generic_string()] = node;
+        realPathsToSourceNodes[canonicalPath(rootUri.fsPath() / *realPath).generic_string()] = node;
     }
 
     for (auto& child : node->children)
@@ -463,6 +481,11 @@ void WorkspaceFileResolver::updateSourceMap(const std::string& sourceMapContents
 {
     realPathsToSourceNodes.clear();
     virtualPathsToSourceNodes.clear();
+    {
+        // The sourcemap is regenerated when files are moved around, so any canonicalised paths may now be stale
+        std::lock_guard guard(canonicalPathsMutex);
+        canonicalPaths.clear();
+    }
 
     try
     {
@@ -4,10 +4,10 @@
 
 struct CliClient : public BaseClient
 {
-    ClientConfiguration configuration;
+    ClientConfigurationPtr configuration = makeConfigurationSnapshot({});
     mutable std::vector<std::pair<std::filesystem::path, std::string>> diagnostics{};
 
-    const ClientConfiguration getConfiguration(const lsp::DocumentUri& uri) override
+    ClientConfigurationPtr getConfiguration(const lsp::DocumentUri& uri) override
     {
         return configuration;
     }
@@ -0,0 +1,58 @@
+#pragma once
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Luau/Location.h"
+
+/// Records the calls made by the functions of each module, keyed by the identity of the function being called (the module
+/// and location it was defined at), so that finding the incoming calls of a function does not require visiting every dependent module
+class CallGraphIndex
+{
+public:
+    struct Call
+    {
+        /// The module and location the called function was defined at
+        std::string definitionModuleName;
+        Luau::Location definitionLocation;
+        /// The location of the function expression being called
+        Luau::Location location;
+    };
+
+    /// A function of the module, alongside the calls it makes
+    struct Caller
+    {
+        std::string name;
+        std::optional<std::string> detail;
+        /// The location of the function and its name, or nullopt for the calls made outside of any function
+        std::optional<std::pair<Luau::Location, Luau::Location>> locations;
+        std::vector<Call> calls;
+    };
+
+    /// Replaces the callers recorded for the module
+    void update(const std::string& moduleName, std::vector<Caller> callers);
+    void remove(const std::string& moduleName);
+    void clear();
+
+    /// Returns each caller within the module which calls the function defined at the given module and location,
+    /// alongside the locations of its calls to it. Callers are returned in the order they were recorded
+    std::vector<std::pair<const Caller*, std::vector<Luau::Location>>> findIncomingCalls(
+        const std::string& moduleName, const std::string& definitionModuleName, const Luau::Location& definitionLocation) const;
+
+    bool contains(const std::string& moduleName) const
+    {
+        return modules.find(moduleName) != modules.end();
+    }
+
+private:
+    struct ModuleCalls
+    {
+        std::vector<Caller> callers;
+        /// Definition module name -> the callers which call any function defined in that module
+        std::unordered_map<std::string, std::vector<size_t>> callersByDefinitionModule;
+    };
+
+    std::unordered_map<std::string, ModuleCalls> modules;
+};
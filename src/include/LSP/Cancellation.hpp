@@ -0,0 +1,40 @@
+#pragma once
+#include <atomic>
+#include <exception>
+#include <memory>
+
+/// A flag shared between a running request and the server, set when the client cancels the request
+class CancellationToken
+{
+public:
+    void cancel()
+    {
+        cancelled.store(true);
+    }
+
+    bool requested() const
+    {
+        return cancelled.load();
+    }
+
+private:
+    std::atomic<bool> cancelled = false;
+};
+
+using LSPCancellationToken = std::shared_ptr<CancellationToken>;
+
+/// Thrown from within a request once its cancellation has been requested.
+/// This is caught by the request dispatcher, which responds with RequestCancelled
+struct RequestCancelledException : public std::exception
+{
+    const char* what() const noexcept override
+    {
+        return "request cancelled";
+    }
+};
+
+inline void throwIfCancelled(const LSPCancellationToken& cancellationToken)
+{
+    if (cancellationToken && cancellationToken->requested())
+        throw RequestCancelledException();
+}
@@ -1,5 +1,7 @@
 #pragma once
 #include <optional>
+#include <atomic>
+#include <mutex>
 #include "Luau/Documentation.h"
 #include "Protocol/Lifecycle.hpp"
 #include "Protocol/ClientCapabilities.hpp"
@@ -9,16 +11,18 @@
 #include "Protocol/Workspace.hpp"
 #include "LSP/JsonRpc.hpp"
 #include "LSP/ClientConfiguration.hpp"
+#include "LSP/DefinitionsSnapshot.hpp"
 
 using namespace json_rpc;
 using ResponseHandler = std::function<void(const JsonRpcMessage&)>;
-using ConfigChangedCallback = std::function<void(const lsp::DocumentUri&, const ClientConfiguration&, /* oldConfig: */ const ClientConfiguration*)>;
+using ConfigChangedCallback =
+    std::function<void(const lsp::DocumentUri&, const ClientConfigurationPtr&, /* oldConfig: */ const ClientConfigurationPtr&)>;
 
 struct BaseClient
 {
     virtual ~BaseClient() {}
 
-    virtual const ClientConfiguration getConfiguration(const lsp::DocumentUri& uri) = 0;
+    virtual ClientConfigurationPtr getConfiguration(const lsp::DocumentUri& uri) = 0;
 
     virtual void publishDiagnostics(const lsp::PublishDiagnosticsParams& params) = 0;
 };
@@ -29,30 +33,44 @@ class Client : public BaseClient
 public:
     lsp::ClientCapabilities capabilities;
     lsp::TraceValue traceMode = lsp::TraceValue::Off;
-    /// A registered definitions file passed by the client
-    std::vector<std::filesystem::path> definitionsFiles{};
+    /// The registered definitions files passed by the client, read once on startup
+    DefinitionsSnapshot definitions{};
     /// A registered documentation file passed by the client
     std::vector<std::filesystem::path> documentationFiles{};
+    /// A directory to persist caches in between sessions, such as the require graph. Caching is disabled if not provided
+    std::optional<std::filesystem::path> cacheDirectory = std::nullopt;
     /// Parsed documentation database
     Luau::DocumentationDatabase documentation{""};
-    /// Global configuration. These are the default settings that we will use if we don't have the workspace stored in configStore
-    ClientConfiguration globalConfig{};
-    /// Configuration passed from the language client. Currently we only handle configuration at the workspace level
-    std::unordered_map<std::string /* DocumentUri */, ClientConfiguration> configStore{};
-
     ConfigChangedCallback configChangedCallback;
 
-    // A partial result token for workspace diagnostics
-    // If this is present, we can stream results
+private:
+    /// The in-progress workspace diagnostics request, alongside its partial result token.
+    /// If the token is present, we can stream results
     std::optional<id_type> workspaceDiagnosticsRequestId = std::nullopt;
     std::optional<lsp::ProgressToken> workspaceDiagnosticsToken = std::nullopt;
+    /// Guards the workspace diagnostics request, as it is cancelled from the input thread without taking the workspace lock
+    std::mutex workspaceDiagnosticsMutex;
+
+    /// Global configuration. These are the default settings that we will use if we don't have the workspace stored in configStore
+    ClientConfigurationPtr globalConfig = makeConfigurationSnapshot({});
+    /// Configuration passed from the language client. Currently we only handle configuration at the workspace level
+    std::unordered_map<std::string /* DocumentUri */, ClientConfigurationPtr> configStore{};
+    /// Guards the global configuration and the config store, as configuration is looked up by requests running on worker threads
+    std::mutex configMutex;
 
-private:
     /// The request id for the next request
-    int nextRequestId = 0;
+    std::atomic<int> nextRequestId = 0;
     std::unordered_map<id_type, ResponseHandler> responseHandler{};
+    std::mutex responseHandlerMutex;
+    /// Messages may be sent from multiple worker threads. They are queued up and written to stdout on a dedicated thread
+    json_rpc::MessageWriter writer;
+    /// Reads messages from stdin. Only ever used by the input thread
+    json_rpc::MessageReader reader = json_rpc::MessageReader::fromFileDescriptor(0);
 
 public:
+    /// Creates a client which writes messages using the given function. By default, messages are written to stdout
+    explicit Client(json_rpc::MessageWriter::WriteFunction writeFn = json_rpc::MessageWriter::fileDescriptorWriter(1));
+
     void sendRequest(const id_type& id, const std::string& method, const std::optional<json>& params,
         const std::optional<ResponseHandler>& handler = std::nullopt);
     void sendResponse(const id_type& id, const json& result);
@@ -70,22 +88,39 @@ public:
 
     void registerCapability(const std::string& registrationId, const std::string& method, const json& registerOptions);
 
-    const ClientConfiguration getConfiguration(const lsp::DocumentUri& uri) override;
+    ClientConfigurationPtr getConfiguration(const lsp::DocumentUri& uri) override;
+    ClientConfigurationPtr getGlobalConfiguration();
+    void setGlobalConfiguration(const ClientConfiguration& config);
     void removeConfiguration(const lsp::DocumentUri& uri);
+    /// Removes all workspace configuration, so that the global configuration is used until configuration is next received
+    void clearConfiguration();
     // TODO: this function only supports getting requests for workspaces
     void requestConfiguration(const std::vector<lsp::DocumentUri>& uris);
     void applyEdit(const lsp::ApplyWorkspaceEditParams& params, const std::optional<ResponseHandler>& handler = std::nullopt);
     void publishDiagnostics(const lsp::PublishDiagnosticsParams& params) override;
     void refreshWorkspaceDiagnostics();
     void terminateWorkspaceDiagnostics(bool retriggerRequest = true);
+    /// Terminates any previous workspace diagnostics request, and records the new request as in-progress
+    void beginWorkspaceDiagnostics(const id_type& id, const std::optional<lsp::ProgressToken>& partialResultToken);
+    bool isWorkspaceDiagnosticsRequest(const id_type& id);
+    std::optional<lsp::ProgressToken> getWorkspaceDiagnosticsToken();
+    /// Responds to the workspace diagnostics request as cancelled, if it is the in-progress request
+    void cancelWorkspaceDiagnostics(const id_type& id);
+    /// Marks the workspace diagnostics request as responded to, if it is the in-progress request
+    void finishWorkspaceDiagnostics(const id_type& id);
     void refreshInlayHints();
 
     void setTrace(const lsp::SetTraceParams& params);
 
-    bool readRawMessage(std::string& output);
+    /// Reads the next message from stdin. The view remains valid until the next call.
+    /// Returns false once the input has been closed
+    bool readRawMessage(std::string_view& output);
 
     void handleResponse(const JsonRpcMessage& message);
 
+    /// Blocks until all queued messages have been written to the output
+    void flush();
+
 private:
-    void sendRawMessage(const json& message);
+    void sendRawMessage(const json& message, const std::optional<std::string>& supersedeKey = std::nullopt);
 };
\ No newline at end of file
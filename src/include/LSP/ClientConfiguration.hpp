@@ -1,6 +1,10 @@
 #pragma once
+#include <filesystem>
+#include <memory>
+#include <unordered_set>
 #include <vector>
 #include "nlohmann/json.hpp"
+#include "LSP/GlobMatcher.hpp"
 
 struct ClientDiagnosticsConfiguration
 {
@@ -10,8 +14,10 @@ struct ClientDiagnosticsConfiguration
     bool workspace = false;
     /// Whether to use expressive DM types in the diagnostics typechecker
     bool strictDatamodelTypes = true;
+    /// How long to wait after a file is last changed before recomputing its diagnostics, in milliseconds (push diagnostics only)
+    size_t pushDebounce = 150;
 };
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(ClientDiagnosticsConfiguration, includeDependents, workspace, strictDatamodelTypes);
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(ClientDiagnosticsConfiguration, includeDependents, workspace, strictDatamodelTypes, pushDebounce);
 
 struct ClientSourcemapConfiguration
 {
@@ -163,9 +169,12 @@ struct ClientIndexConfiguration
     bool enabled = true;
     /// The maximum amount of files that can be indexed
     size_t maxFiles = 10000;
+    /// Whether open files and their dependencies should be typechecked in the background whilst the server is idle,
+    /// so that the first request in a file does not have to wait for them to be typechecked
+    bool preTypecheck = true;
 };
 
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(ClientIndexConfiguration, enabled, maxFiles);
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(ClientIndexConfiguration, enabled, maxFiles, preTypecheck);
 
 struct ClientFFlagsConfiguration
 {
@@ -201,6 +210,21 @@ struct ClientConfiguration
     ClientRequireConfiguration require{};
     ClientIndexConfiguration index{};
     ClientFFlagsConfiguration fflags{};
+
+    // The following are derived from the settings above once, when the snapshot is created (see `makeConfigurationSnapshot`),
+    // rather than on every lookup. They are not part of the client's settings
+
+    /// The compiled `ignoreGlobs`. Only nullptr if the configuration was not created as a snapshot
+    std::shared_ptr<const GlobMatcher> ignoreGlobMatcher = nullptr;
+    /// The weakly canonical paths of `types.definitionFiles`
+    std::unordered_set<std::string> canonicalDefinitionFiles{};
 };
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(ClientConfiguration, autocompleteEnd, ignoreGlobs, sourcemap, diagnostics, types, inlayHints, hover,
     completion, signatureHelp, require, index, fflags);
+
+/// An immutable snapshot of the configuration. A new snapshot is created whenever the configuration changes, so a snapshot can be
+/// held onto for the duration of a request, and shared across threads, without being copied
+using ClientConfigurationPtr = std::shared_ptr<const ClientConfiguration>;
+
+/// Creates an immutable snapshot of the configuration, computing the data derived from its settings
+ClientConfigurationPtr makeConfigurationSnapshot(ClientConfiguration configuration);
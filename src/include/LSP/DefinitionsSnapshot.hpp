@@ -0,0 +1,29 @@
+#pragma once
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+/// The contents of the definitions files, read once when the server starts and shared by every workspace folder,
+/// rather than each folder re-reading (and re-hashing) the files from disk. This does not hold the checked definitions:
+/// every global environment still parses and checks the contents itself
+struct DefinitionsSnapshot
+{
+    struct File
+    {
+        std::filesystem::path path;
+        /// The contents of the file, or nullopt if it could not be read
+        std::optional<std::string> contents;
+    };
+
+    std::vector<File> files{};
+    /// A hash of the contents of every file, in order
+    uint64_t hash = 0;
+
+    static DefinitionsSnapshot load(const std::vector<std::filesystem::path>& paths);
+
+    bool empty() const
+    {
+        return files.empty();
+    }
+};
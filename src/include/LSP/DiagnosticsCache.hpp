@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+
+#include "nlohmann/json.hpp"
+
+using json = nlohmann::json;
+
+/// The computed diagnostics of every file in a workspace, persisted between sessions so that files whose inputs have not changed
+/// do not need to be typechecked again. Each entry is keyed by a hash of everything which affects the diagnostics of the file
+class DiagnosticsCache
+{
+public:
+    /// Loads the cache from the file. If the file could not be read, an empty cache is returned
+    static DiagnosticsCache load(const std::filesystem::path& path);
+    /// Writes the cache to the file. Returns false if the file could not be written
+    bool save(const std::filesystem::path& path);
+
+    /// The file within the cache directory used to store the cache of a workspace
+    static std::filesystem::path pathForWorkspace(const std::filesystem::path& cacheDirectory, const std::string& workspaceUri);
+
+    /// Returns the cached diagnostics for the file, or nullptr if there is no entry or it was computed from different inputs
+    const json* find(const std::string& uri, uint64_t key) const;
+    void insert(const std::string& uri, uint64_t key, json diagnostics);
+
+    /// Whether the cache has been changed since it was loaded or last saved
+    bool isModified() const
+    {
+        return modified;
+    }
+
+    size_t size() const
+    {
+        return entries.size();
+    }
+
+private:
+    struct Entry
+    {
+        uint64_t key = 0;
+        json diagnostics;
+    };
+
+    std::unordered_map<std::string, Entry> entries;
+    bool modified = false;
+};
@@ -0,0 +1,85 @@
+#pragma once
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// The Luau source files found within a directory. The directory is walked once, and then kept up to date through
+/// file change notifications, so that repeated lookups do not need to touch the filesystem
+class FileInventory
+{
+public:
+    /// Per-file information which depends on the configuration, such as whether the file is ignored.
+    /// This is computed once per file, and only recomputed when the configuration changes
+    struct Classification
+    {
+        bool definitionFile = false;
+        bool ignored = false;
+    };
+
+    struct Entry
+    {
+        std::filesystem::path path;
+        Classification classification{};
+        bool classified = false;
+    };
+
+    using Classifier = std::function<Classification(const std::filesystem::path&)>;
+    /// Returns true if the contents of the directory should not be included in the inventory
+    using DirectoryFilter = std::function<bool(const std::filesystem::path&)>;
+
+    explicit FileInventory(std::filesystem::path root = {});
+
+    static bool isSourceFile(const std::filesystem::path& path);
+
+    bool isBuilt() const
+    {
+        return built;
+    }
+
+    /// Marks the inventory as needing to be rebuilt, e.g. because the directory filter has changed
+    void invalidate()
+    {
+        built = false;
+    }
+
+    /// Walks the root directory, replacing the current contents of the inventory.
+    /// Directories for which `skipDirectory` returns true are not walked, both now and when added later
+    void build(DirectoryFilter skipDirectory = nullptr);
+
+    /// Adds a newly created file. If the path is a directory, all the source files within it are added.
+    /// Files which are not source files, are already present, or are within a skipped directory are ignored
+    void add(const std::filesystem::path& path);
+    /// Removes a deleted file. If the path is a directory, all the files within it are removed
+    void remove(const std::filesystem::path& path);
+
+    /// Returns every file in the inventory, without classifying them
+    const std::vector<Entry>& entries() const
+    {
+        return files;
+    }
+
+    /// Returns every file in the inventory. Any unclassified file is classified using `classify`.
+    /// If `classificationKey` differs from the key used previously, every file is reclassified
+    const std::vector<Entry>& entries(const std::string& classificationKey, const Classifier& classify);
+
+    size_t size() const
+    {
+        return files.size();
+    }
+
+private:
+    /// Whether the directory, or any of its ancestors within the root, is skipped by the directory filter
+    bool isSkipped(const std::filesystem::path& directory) const;
+    void addDirectory(const std::filesystem::path& directory);
+    void insert(const std::filesystem::path& path);
+
+    std::filesystem::path root;
+    DirectoryFilter skipDirectory = nullptr;
+    bool built = false;
+    std::vector<Entry> files;
+    /// The index of each file in `files`, keyed by the generic path
+    std::unordered_map<std::string, size_t> indices;
+    std::string classificationKey;
+};
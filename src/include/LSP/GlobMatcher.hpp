@@ -0,0 +1,36 @@
+#pragma once
+#include <mutex>
+#include <optional>
+#include <regex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// A set of glob patterns compiled into a single regular expression, for matching paths relative to the workspace root.
+/// Results are memoised per path, as the same paths are checked repeatedly (e.g. when indexing and computing workspace diagnostics)
+class GlobMatcher
+{
+public:
+    explicit GlobMatcher(std::vector<std::string> patterns);
+
+    const std::vector<std::string>& getPatterns() const
+    {
+        return patterns;
+    }
+
+    /// Whether the path matches any of the patterns
+    bool matches(const std::string& relativePath) const;
+
+    /// Whether every path within the directory matches one of the patterns, meaning the directory does not need to be walked.
+    /// This is only detected for patterns ending in `*`, such as `**/node_modules/**`
+    bool matchesEntireDirectory(const std::string& relativeDirectory) const;
+
+private:
+    std::vector<std::string> patterns;
+    std::optional<std::regex> regex = std::nullopt;
+    /// Patterns ending in `*`, with the trailing `*`s removed
+    std::optional<std::regex> directoryRegex = std::nullopt;
+
+    mutable std::mutex cacheMutex;
+    mutable std::unordered_map<std::string, bool> cache;
+};
@@ -1,7 +1,15 @@
 #pragma once
 #include <exception>
+#include <functional>
 #include <variant>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 #include <iostream>
+#include <string_view>
 #include "Luau/StringUtils.h"
 #include "nlohmann/json.hpp"
 #include "Protocol/Base.hpp"
@@ -60,12 +68,84 @@ public:
     }
 };
 
-JsonRpcMessage parse(const std::string& jsonString);
+JsonRpcMessage parse(std::string_view jsonString);
 
-/// Reads a JSON-RPC message from input
-bool readRawMessage(std::istream& input, std::string& output);
+/// Reads JSON-RPC messages from a raw input source through a single reusable buffer.
+/// Headers are parsed in place, and message bodies are returned as views into the buffer, so no allocations
+/// are made per message once the buffer has grown to fit the largest message seen.
+class MessageReader
+{
+public:
+    /// Reads up to `size` bytes into `buffer`, returning the number of bytes read, or 0 once the input is exhausted
+    using ReadFunction = std::function<size_t(char* buffer, size_t size)>;
+
+    explicit MessageReader(ReadFunction readFn, size_t initialCapacity = 1 << 20);
+
+    /// Creates a reader over a raw file descriptor (e.g., 0 for stdin)
+    static MessageReader fromFileDescriptor(int fd);
+
+    /// Reads the next message body into `output`. The view remains valid until the next call to `read`.
+    /// Returns false once the input is exhausted
+    bool read(std::string_view& output);
+
+private:
+    /// Reads more data onto the end of the buffer, growing it if necessary so that it can hold `required` unconsumed bytes
+    bool fill(size_t required);
+
+    ReadFunction readFn;
+    size_t initialCapacity;
+    std::vector<char> buffer;
+    /// The range of unconsumed data held in the buffer
+    size_t start = 0;
+    size_t end = 0;
+};
+
+/// Writes JSON-RPC messages to a raw output sink on a dedicated thread, so that senders are not blocked on a slow reader.
+/// All messages queued whilst a write is in progress are coalesced into a single write.
+class MessageWriter
+{
+public:
+    /// Writes all `size` bytes of `data`, returning false if the output has been closed
+    using WriteFunction = std::function<bool(const char* data, size_t size)>;
+
+    explicit MessageWriter(WriteFunction writeFn);
+    /// Writes out any remaining queued messages before stopping the writer thread
+    ~MessageWriter();
+
+    MessageWriter(const MessageWriter&) = delete;
+    MessageWriter& operator=(const MessageWriter&) = delete;
+
+    /// Creates a writer over a raw file descriptor (e.g., 1 for stdout)
+    static WriteFunction fileDescriptorWriter(int fd);
+
+    /// Queues a serialised message to be written.
+    /// If a `supersedeKey` is provided, any message with the same key still waiting in the queue is dropped, as it is now stale
+    void write(std::string message, const std::optional<std::string>& supersedeKey = std::nullopt);
 
-/// Sends a raw JSON-RPC message to output stream
-void sendRawMessage(std::ostream& output, const json& message);
+    /// Blocks until all currently queued messages have been written
+    void flush();
+
+private:
+    struct QueuedMessage
+    {
+        std::string message;
+        std::optional<std::string> supersedeKey;
+        size_t sequence;
+    };
+
+    void writerLoop();
+
+    WriteFunction writeFn;
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::condition_variable flushedCondition;
+    std::deque<QueuedMessage> queue;
+    /// The sequence number of the latest queued message for each supersede key
+    std::unordered_map<std::string, size_t> latestSequence;
+    size_t nextSequence = 0;
+    size_t writtenSequence = 0;
+    bool stopping = false;
+    std::thread thread;
+};
 
 } // namespace json_rpc
\ No newline at end of file
@@ -1,5 +1,11 @@
 #include <optional>
+#include <chrono>
 #include <filesystem>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <deque>
+#include <unordered_set>
 
 #include "nlohmann/json.hpp"
 
@@ -7,8 +13,12 @@
 #include "Protocol/LanguageFeatures.hpp"
 
 #include "LSP/Client.hpp"
+#include "LSP/Cancellation.hpp"
 #include "LSP/JsonRpc.hpp"
+#include "LSP/Replay.hpp"
+#include "LSP/Statistics.hpp"
 #include "LSP/Workspace.hpp"
+#include "LSP/WorkerPool.hpp"
 
 using json = nlohmann::json;
 using namespace json_rpc;
@@ -32,10 +42,65 @@ private:
     std::vector<WorkspaceFolderPtr> workspaceFolders;
     ClientPtr client;
     const std::optional<Luau::Config>& defaultConfig;
+    /// If present, the collected statistics are written to this file when the server exits
+    std::optional<std::filesystem::path> statisticsFile;
+    std::unique_ptr<SessionRecorder> recorder;
+
+    /// Guards all workspace state. Document mutations and requests which run the typechecker (which mutates the Frontend)
+    /// take an exclusive lock, whilst parse-only requests take a shared lock and can run concurrently
+    std::shared_mutex workspaceMutex;
+
+    /// The number of requests handed to the worker pool that have not yet acquired the workspace lock.
+    /// Mutations wait for this to hit zero so that every request observes the workspace as it was when the request arrived
+    size_t pendingRequests = 0;
+    std::mutex pendingRequestsMutex;
+    std::condition_variable pendingRequestsCondition;
+
+    /// Cancellation tokens of dispatched requests which have not yet completed, keyed by request id
+    std::unordered_map<id_type, LSPCancellationToken> cancellationTokens;
+    std::mutex cancellationTokensMutex;
+
+    /// Files whose diagnostics need to be recomputed in the background, as a dependency of theirs was edited (push diagnostics mode).
+    /// Only accessed whilst holding an exclusive workspace lock
+    struct PendingDiagnostics
+    {
+        std::deque<Uri> queue;
+        std::unordered_set<std::string> queued;
+        bool scheduled = false;
+    };
+    std::unordered_map<WorkspaceFolderPtr, PendingDiagnostics> pendingDependentDiagnostics;
+    /// Edited files waiting for their debounce window to elapse before their diagnostics are recomputed (push diagnostics mode), keyed by uri.
+    /// Only accessed whilst holding an exclusive workspace lock
+    struct DebouncedDiagnostics
+    {
+        WorkspaceFolderPtr workspace;
+        /// Reverse dependencies marked dirty by every edit made within the window
+        std::vector<Uri> dependents;
+        /// Incremented on every edit, so that only the recomputation scheduled by the most recent edit goes ahead
+        size_t generation = 0;
+    };
+    std::unordered_map<std::string, DebouncedDiagnostics> debouncedDiagnostics;
+    /// Tokens for in-progress background diagnostics recomputation, so that it can be abandoned if it is recomputed again
+    std::unordered_map<WorkspaceFolderPtr, LSPCancellationToken> recomputeDiagnosticsTokens;
+    /// Tokens for in-progress background pre-typechecking, so that it can be restarted once documents change again
+    std::unordered_map<WorkspaceFolderPtr, LSPCancellationToken> preTypecheckTokens;
+
+    /// The number of files typechecked in parallel per unit of background work when computing workspace diagnostics.
+    /// Larger batches allow for more parallelism, but hold up incoming requests for longer
+    static constexpr size_t WorkspaceDiagnosticsBatchSize = 128;
+
+    // NOTE: declared after the state used by queued tasks, so that the workers are joined before that state is destroyed
+    WorkerPool workerPool;
+    /// A single worker which hands off incoming messages in the order they were received: requests are pushed onto the worker pool,
+    /// whilst mutations (notifications, responses and lifecycle requests) are applied once every earlier request has run.
+    /// This keeps the input thread free to read in messages (such as cancellations) whilst a mutation waits on a long-running request
+    // NOTE: declared after the worker pool, as its tasks push onto the pool
+    WorkerPool dispatchQueue{1};
 
 public:
-    explicit LanguageServer(const std::vector<std::filesystem::path>& definitionsFiles, const std::vector<std::filesystem::path>& documentationFiles,
-        const std::optional<Luau::Config>& defaultConfig);
+    LanguageServer(ClientPtr client, const std::vector<std::filesystem::path>& definitionsFiles,
+        const std::vector<std::filesystem::path>& documentationFiles, const std::optional<Luau::Config>& defaultConfig,
+        const std::optional<std::filesystem::path>& statisticsFile = std::nullopt);
 
     lsp::ServerCapabilities getServerCapabilities();
 
@@ -43,18 +108,70 @@ public:
     /// If no workspace is found, the file is attached to the null workspace
     WorkspaceFolderPtr findWorkspace(const lsp::DocumentUri& file);
 
-    void onRequest(const id_type& id, const std::string& method, std::optional<json> params);
+    void onRequest(const id_type& id, const std::string& method, std::optional<json> params, const LSPCancellationToken& cancellationToken = nullptr);
     void onNotification(const std::string& method, std::optional<json> params);
+    /// Parses and handles a single raw JSON-RPC message. Requests are handed off to the worker pool
+    void processMessage(std::string_view jsonString);
     void processInputLoop();
+    /// Records every inbound message read by the input loop to the file, so that the session can later be replayed
+    void recordSession(const std::filesystem::path& path);
+    /// Blocks until all dispatched requests have completed
+    void waitForPendingRequests();
     bool requestedShutdown();
+    /// Writes the collected statistics to the statistics file, if one was provided
+    void dumpStatistics();
+
+    /// Whether the request only requires parsed source modules, and can be run concurrently with other read-only requests
+    static bool isReadOnlyRequest(const std::string& method);
+
+private:
+    /// Hands the request off to the worker pool through the dispatch queue, or applies it as a mutation if it is a lifecycle request
+    void dispatchRequest(const id_type& id, const std::string& method, std::optional<json> params);
+    /// Applies the notification as a mutation, recording its queue wait and execution time
+    void dispatchNotification(const std::string& method, std::optional<json> params);
+    /// Queues the mutation onto the dispatch queue, where it is applied with an exclusive workspace lock once every previously
+    /// dispatched request has run. Any thrown errors are sent back to the client
+    void dispatchMutation(std::function<void()> mutation);
+    /// Unregisters the cancellation token of a request once it has completed, unless the id has since been reused by a newer request
+    void releaseCancellationToken(const id_type& id, const LSPCancellationToken& cancellationToken);
+    /// Runs `onRequest`, sending any thrown errors back to the client
+    void handleRequest(
+        const id_type& id, const std::string& method, const std::optional<json>& params, const LSPCancellationToken& cancellationToken);
+    /// Acquires an exclusive lock on the workspace once all previously dispatched requests have started
+    std::unique_lock<std::shared_mutex> lockForMutation();
+    /// Acquires an exclusive lock on the workspace for a unit of background work. Returns std::nullopt if there are
+    /// dispatched requests still waiting to run, in which case the background work should give way to them
+    std::optional<std::unique_lock<std::shared_mutex>> tryLockForBackgroundWork();
+    /// The priority to run a request at. Keystroke-latency requests are prioritised ahead of everything else
+    static TaskPriority requestPriority(const std::string& method);
+    /// Runs bulk work on the worker pool at background priority. `step` should process a single unit of work (e.g. one module),
+    /// returning true if there is more work remaining. Each step acquires the workspace lock separately, so requests which arrive
+    /// in the meantime can run in between steps. If a step throws, the error is logged and the remaining work continues,
+    /// unless it threw RequestCancelledException, in which case the work is abandoned
+    void scheduleBackgroundWork(std::function<bool()> step);
+    /// Runs `work` on the worker pool, holding an exclusive workspace lock, once the delay has elapsed.
+    /// Like background work, it gives way to any dispatched requests which are still waiting to run
+    void scheduleDelayedWork(std::chrono::milliseconds delay, std::function<void()> work);
+    /// Initialises the workspaces, loading the builtin and definitions file types into each of their global environments
+    void initializeWorkspaces(const std::vector<WorkspaceFolderPtr>& workspaces);
 
     // Dispatch handlers
 private:
     lsp::InitializeResult onInitialize(const lsp::InitializeParams& params);
     void onInitialized(const lsp::InitializedParams& params);
-
-    void pushDiagnostics(WorkspaceFolderPtr& workspace, const lsp::DocumentUri& uri, const size_t version);
-    void recomputeDiagnostics(WorkspaceFolderPtr& workspace, const ClientConfiguration& config);
+    void onCancelRequest(const lsp::CancelParams& params);
+
+    lsp::DocumentDiagnosticReport pushDiagnostics(WorkspaceFolderPtr& workspace, const lsp::DocumentUri& uri, const std::optional<size_t> version);
+    /// Queues the files to have their diagnostics recomputed in the background
+    void pushDependentDiagnostics(const WorkspaceFolderPtr& workspace, const std::vector<Uri>& uris);
+    /// Recomputes the diagnostics of an edited file once it has not been changed for the debounce window, followed by
+    /// its reverse dependencies. Consecutive edits within the window are coalesced into a single recomputation
+    void pushDebouncedDiagnostics(
+        const WorkspaceFolderPtr& workspace, const lsp::DocumentUri& uri, std::vector<Uri> dependents, std::chrono::milliseconds debounce);
+    void recomputeDiagnostics(WorkspaceFolderPtr& workspace, const ClientConfigurationPtr& config);
+    /// Once the workspace has been idle for a while, typechecks the open documents and their transitive requires in the background
+    /// (retaining type graphs), so that interactive requests find them already checked. Restarts any previously scheduled pre-typecheck
+    void schedulePreTypecheck(const WorkspaceFolderPtr& workspace);
 
     void onDidOpenTextDocument(const lsp::DidOpenTextDocumentParams& params);
     void onDidChangeTextDocument(const lsp::DidChangeTextDocumentParams& params);
@@ -66,23 +183,24 @@ private:
     void onStudioPluginFullChange(const PluginNode& dataModel);
     void onStudioPluginClear();
 
-    std::vector<lsp::CompletionItem> completion(const lsp::CompletionParams& params);
+    std::vector<lsp::CompletionItem> completion(const lsp::CompletionParams& params, const LSPCancellationToken& cancellationToken);
     std::vector<lsp::DocumentLink> documentLink(const lsp::DocumentLinkParams& params);
     lsp::DocumentColorResult documentColor(const lsp::DocumentColorParams& params);
     lsp::ColorPresentationResult colorPresentation(const lsp::ColorPresentationParams& params);
     lsp::CodeActionResult codeAction(const lsp::CodeActionParams& params);
 
-    std::optional<lsp::Hover> hover(const lsp::HoverParams& params);
-    std::optional<lsp::SignatureHelp> signatureHelp(const lsp::SignatureHelpParams& params);
+    std::optional<lsp::Hover> hover(const lsp::HoverParams& params, const LSPCancellationToken& cancellationToken);
+    std::optional<lsp::SignatureHelp> signatureHelp(const lsp::SignatureHelpParams& params, const LSPCancellationToken& cancellationToken);
     lsp::DefinitionResult gotoDefinition(const lsp::DefinitionParams& params);
     std::optional<lsp::Location> gotoTypeDefinition(const lsp::TypeDefinitionParams& params);
-    lsp::ReferenceResult references(const lsp::ReferenceParams& params);
+    lsp::ReferenceResult references(const lsp::ReferenceParams& params, const LSPCancellationToken& cancellationToken);
     std::optional<std::vector<lsp::DocumentSymbol>> documentSymbol(const lsp::DocumentSymbolParams& params);
-    lsp::RenameResult rename(const lsp::RenameParams& params);
+    lsp::RenameResult rename(const lsp::RenameParams& params, const LSPCancellationToken& cancellationToken);
     lsp::InlayHintResult inlayHint(const lsp::InlayHintParams& params);
     std::optional<lsp::SemanticTokens> semanticTokens(const lsp::SemanticTokensParams& params);
-    lsp::DocumentDiagnosticReport documentDiagnostic(const lsp::DocumentDiagnosticParams& params);
-    lsp::PartialResponse<lsp::WorkspaceDiagnosticReport> workspaceDiagnostic(const lsp::WorkspaceDiagnosticParams& params);
+    lsp::DocumentDiagnosticReport documentDiagnostic(const lsp::DocumentDiagnosticParams& params, const LSPCancellationToken& cancellationToken);
+    /// Computes workspace diagnostics in the background, a module at a time. The response is sent once all modules have been checked
+    void workspaceDiagnostic(const id_type& id, const lsp::WorkspaceDiagnosticParams& params, const LSPCancellationToken& cancellationToken);
     Response onShutdown(const id_type& id);
 
 private:
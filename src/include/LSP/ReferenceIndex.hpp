@@ -0,0 +1,54 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Luau/Location.h"
+
+/// A use of a property of a table type, found whilst typechecking a module
+struct PropertyReference
+{
+    /// The module and location the table type was defined at, which identify the table across modules
+    std::string definitionModuleName;
+    Luau::Location definitionLocation;
+    std::string property;
+    /// The location of the use within the module it was found in
+    Luau::Location location;
+};
+
+/// Records the property references found in each module, so that finding the references of a property does not require
+/// scanning the types of every dependent module again. The references of a module are replaced whenever it is re-checked
+class ReferenceIndex
+{
+public:
+    /// Replaces the references recorded for the module
+    void update(const std::string& moduleName, const std::vector<PropertyReference>& references);
+    void remove(const std::string& moduleName);
+    void clear();
+
+    /// Returns the locations in the module which use the property of the table defined at the given module and location
+    std::vector<Luau::Location> find(const std::string& moduleName, const std::string& definitionModuleName,
+        const Luau::Location& definitionLocation, const std::string& property) const;
+
+    bool contains(const std::string& moduleName) const
+    {
+        return moduleReferences.find(moduleName) != moduleReferences.end();
+    }
+
+    /// The number of modules which have been recorded
+    size_t size() const
+    {
+        return moduleReferences.size();
+    }
+
+private:
+    struct Use
+    {
+        std::string definitionModuleName;
+        Luau::Location definitionLocation;
+        Luau::Location location;
+    };
+
+    /// Module name -> property name -> uses of a property with that name, on any table
+    std::unordered_map<std::string, std::unordered_map<std::string, std::vector<Use>>> moduleReferences;
+};
@@ -0,0 +1,51 @@
+#pragma once
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class LanguageServer;
+
+/// Records every inbound JSON-RPC message, alongside the time (relative to the start of the session) at which it was received.
+/// The session is written in the JSON Lines format: `{"time": <milliseconds>, "message": <message>}`
+class SessionRecorder
+{
+public:
+    explicit SessionRecorder(const std::filesystem::path& path);
+
+    bool isOpen() const
+    {
+        return output.is_open();
+    }
+
+    void record(std::string_view message);
+
+private:
+    std::ofstream output;
+    std::chrono::steady_clock::time_point startTime;
+};
+
+struct RecordedMessage
+{
+    /// Milliseconds since the start of the session
+    double time = 0.0;
+    std::string message;
+};
+
+/// Loads a session written by a SessionRecorder. Throws a std::runtime_error if the session could not be read
+std::vector<RecordedMessage> loadRecordedSession(const std::filesystem::path& path);
+
+struct ReplayOptions
+{
+    /// If present, the workspace root of the recorded session is remapped to this directory
+    std::optional<std::filesystem::path> workspace = std::nullopt;
+    /// Whether to wait between messages for the same amount of time as in the recorded session.
+    /// Otherwise, messages are sent as fast as they can be read
+    bool realtime = false;
+};
+
+/// Drives the language server through a recorded session, then reports per-method latency and total resource usage to stdout
+void replaySession(LanguageServer& server, std::vector<RecordedMessage> session, const ReplayOptions& options);
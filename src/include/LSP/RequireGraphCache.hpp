@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// Identifies a version of a file on disk, without needing to read it in
+struct FileStamp
+{
+    int64_t lastWriteTime = 0;
+    uintmax_t size = 0;
+
+    /// Returns std::nullopt if the file could not be found
+    static std::optional<FileStamp> of(const std::filesystem::path& path);
+
+    bool operator==(const FileStamp& rhs) const
+    {
+        return lastWriteTime == rhs.lastWriteTime && size == rhs.size;
+    }
+
+    bool operator!=(const FileStamp& rhs) const
+    {
+        return !(*this == rhs);
+    }
+};
+
+/// The resolved requires of every indexed module in a workspace, persisted between sessions so that files which have not
+/// changed since the last session do not need to be read in and parsed on startup
+class RequireGraphCache
+{
+public:
+    struct Entry
+    {
+        std::string moduleName;
+        /// The version of the file the requires were resolved from
+        FileStamp stamp;
+        /// The module names of the modules required by this module
+        std::vector<std::string> requiredModules;
+    };
+
+    /// The fingerprint identifies all state other than the file contents which affects how requires are resolved,
+    /// such as the sourcemap and the require configuration
+    explicit RequireGraphCache(std::string fingerprint);
+
+    /// Loads the cache from the file. If the file could not be read, or was written with a different fingerprint, an empty cache is returned
+    static RequireGraphCache load(const std::filesystem::path& path, const std::string& fingerprint);
+    /// Writes the cache to the file. Returns false if the file could not be written
+    bool save(const std::filesystem::path& path) const;
+
+    /// The file within the cache directory used to store the cache of a workspace
+    static std::filesystem::path pathForWorkspace(const std::filesystem::path& cacheDirectory, const std::string& workspaceUri);
+
+    /// Returns the entry for the file, or nullptr if there is no entry or it is out of date
+    const Entry* find(const std::filesystem::path& filePath, const FileStamp& stamp) const;
+    void insert(const std::filesystem::path& filePath, Entry entry);
+
+    size_t size() const
+    {
+        return entries.size();
+    }
+
+private:
+    std::string fingerprint;
+    /// Keyed by the generic file path
+    std::unordered_map<std::string, Entry> entries;
+};
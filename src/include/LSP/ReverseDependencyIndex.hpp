@@ -0,0 +1,35 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/// Maps each module to the modules which directly require it. The index is updated a module at a time as its requires change,
+/// rather than being rebuilt from the whole require graph whenever the dependents of a module are needed
+class ReverseDependencyIndex
+{
+public:
+    /// Replaces the requires recorded for the module
+    void update(const std::string& moduleName, const std::unordered_set<std::string>& requiredModules);
+    void remove(const std::string& moduleName);
+    void clear();
+
+    /// Returns the module, followed by every module which transitively requires it. Each module is only visited once,
+    /// so this takes time proportional to the size of the result
+    std::vector<std::string> findTransitiveDependents(const std::string& moduleName) const;
+
+    bool contains(const std::string& moduleName) const
+    {
+        return moduleRequires.find(moduleName) != moduleRequires.end();
+    }
+
+    /// The number of modules which have been recorded
+    size_t size() const
+    {
+        return moduleRequires.size();
+    }
+
+private:
+    std::unordered_map<std::string, std::vector<std::string>> moduleRequires;
+    std::unordered_map<std::string, std::unordered_set<std::string>> dependents;
+};
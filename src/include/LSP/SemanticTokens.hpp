@@ -2,6 +2,7 @@
 #include "Luau/Ast.h"
 #include "Luau/Module.h"
 #include "Protocol/SemanticTokens.hpp"
+#include "LSP/TextDocument.hpp"
 
 struct SemanticToken
 {
@@ -11,4 +12,6 @@ struct SemanticToken
     lsp::SemanticTokenModifiers tokenModifiers;
 };
 
-std::vector<SemanticToken> getSemanticTokens(const Luau::ModulePtr& module, Luau::SourceModule* sourceModule);
\ No newline at end of file
+std::vector<SemanticToken> getSemanticTokens(const Luau::ModulePtr& module, Luau::SourceModule* sourceModule);
+/// Sorts the tokens by position, and then encodes them relative to one another in the format expected by the client
+std::vector<size_t> packTokens(const TextDocument* textDocument, std::vector<SemanticToken>& tokens);
\ No newline at end of file
@@ -0,0 +1,100 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include "nlohmann/json.hpp"
+
+using json = nlohmann::json;
+
+/// A fixed-size histogram of durations, recorded at microsecond resolution.
+/// Buckets are log-linear: each power of two is split into 8 sub-buckets, so percentiles are accurate to within 12.5%
+class LatencyHistogram
+{
+public:
+    using Duration = std::chrono::steady_clock::duration;
+
+    void record(Duration duration);
+
+    size_t count() const
+    {
+        return totalCount;
+    }
+
+    /// Returns the approximate duration (in milliseconds) below which `percentile` (0-1) of the recorded durations fall
+    double percentileMs(double percentile) const;
+    double maxMs() const;
+    double totalMs() const;
+
+    json toJson() const;
+
+private:
+    static constexpr size_t SubBucketBits = 3;
+    static constexpr size_t SubBucketCount = 1 << SubBucketBits;
+    static constexpr size_t BucketCount = 64 * SubBucketCount;
+
+    static size_t bucketIndex(uint64_t micros);
+    static uint64_t bucketUpperBound(size_t index);
+
+    std::array<size_t, BucketCount> buckets{};
+    size_t totalCount = 0;
+    uint64_t totalMicros = 0;
+    uint64_t maxMicros = 0;
+};
+
+/// Collects latency histograms for the server, grouped by category (e.g., requests, notifications) and then by name (e.g., method).
+/// This is safe to use from multiple threads
+class Statistics
+{
+public:
+    static constexpr const char* Requests = "requests";
+    static constexpr const char* Notifications = "notifications";
+    /// Time between a message being read and it starting to execute (including time waiting on the workspace lock)
+    static constexpr const char* QueueWait = "queueWait";
+    /// Time spent inside of the Luau frontend (i.e. `Frontend::check` and `Frontend::parse`)
+    static constexpr const char* Frontend = "frontend";
+
+    Statistics();
+
+    void record(const std::string& category, const std::string& name, LatencyHistogram::Duration duration);
+
+    json toJson() const;
+    /// Formats the statistics as a human-readable table
+    std::string toString() const;
+
+    void clear();
+
+private:
+    mutable std::mutex mutex;
+    std::chrono::steady_clock::time_point startTime;
+    std::map<std::string, std::map<std::string, LatencyHistogram>> histograms;
+};
+
+/// The process-wide statistics collector
+Statistics& statistics();
+
+/// Records the time between construction and destruction into the process-wide statistics
+class ScopedTimer
+{
+public:
+    ScopedTimer(const char* category, std::string name)
+        : category(category)
+        , name(std::move(name))
+        , start(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~ScopedTimer()
+    {
+        statistics().record(category, name, std::chrono::steady_clock::now() - start);
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    const char* category;
+    std::string name;
+    std::chrono::steady_clock::time_point start;
+};
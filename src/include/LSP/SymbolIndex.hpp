@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Protocol/LanguageFeatures.hpp"
+
+/// The symbols declared in every module of a workspace, indexed for fuzzy searching by name.
+/// Each module's symbols are replaced as a whole whenever the module changes.
+///
+/// A symbol matches a query if the query is a prefix of its name, or of the name's "humps" (the first letter of each word,
+/// e.g. `gpd` for `getPlayerData` or `get_player_data`). Queries of at least 3 characters also match anywhere within the name.
+/// Matching is case-insensitive. Candidates are found using the trigrams (or for short queries, the first character) of the query,
+/// so a search does not need to scan every symbol
+class SymbolIndex
+{
+public:
+    void update(const std::string& moduleName, std::vector<lsp::WorkspaceSymbol> symbols);
+    void remove(const std::string& moduleName);
+    void clear();
+
+    /// Returns the best `limit` matches for the query. Exact matches rank highest, followed by prefix, hump and substring matches
+    std::vector<lsp::WorkspaceSymbol> search(const std::string& query, size_t limit) const;
+
+    /// The number of symbols in the index
+    size_t size() const
+    {
+        return entries.size() - deadEntries;
+    }
+
+    /// Returns the first letter of each word in the name, lower-cased. Words are split on `_`, and on lower-to-upper case changes
+    static std::string humps(const std::string& name);
+
+private:
+    struct Entry
+    {
+        lsp::WorkspaceSymbol symbol;
+        std::string lowerName;
+        std::string humps;
+        bool alive = true;
+    };
+
+    void insertPostings(size_t entry);
+    /// Drops removed entries, once they outnumber the live entries
+    void compact();
+    /// Returns the match score of the entry for the (lower-cased) query, or 0 if it does not match
+    static int score(const Entry& entry, const std::string& query);
+
+    std::vector<Entry> entries;
+    size_t deadEntries = 0;
+    std::unordered_map<std::string, std::vector<size_t>> moduleEntries;
+    /// Entries containing each trigram of their lower-cased name. The first trigram of the humps, and the first character of the name
+    /// and of the humps, are also posted, distinguished by the top bits of the key
+    std::unordered_map<uint32_t, std::vector<size_t>> trigrams;
+};
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <filesystem>
@@ -14,6 +15,8 @@ std::optional<std::string> getAncestorPath(const std::string& path, const std::s
 std::string convertToScriptPath(const std::string& path);
 std::string codeBlock(const std::string& language, const std::string& code);
 std::optional<std::string> readFile(const std::filesystem::path& filePath);
+/// Writes to a temporary file which then replaces the file, so that concurrent readers never see a partially written file
+bool writeFileAtomically(const std::filesystem::path& filePath, const std::string& contents);
 std::optional<std::filesystem::path> getHomeDirectory();
 std::filesystem::path resolvePath(const std::filesystem::path& path);
 void trim_start(std::string& str);
@@ -23,6 +26,8 @@ std::string& toLower(std::string& str);
 bool endsWith(const std::string_view& str, const std::string_view& suffix);
 bool replace(std::string& str, const std::string& from, const std::string& to);
 void replaceAll(std::string& str, const std::string& from, const std::string& to);
+/// FNV-1a. This is stable across sessions and builds, so can be used for persisted data. Pass in a previous hash to combine them
+uint64_t hashString(std::string_view str, uint64_t hash = 14695981039346656037ull);
 
 template<typename V>
 inline bool contains(const std::vector<V>& vec, const V& value)
@@ -0,0 +1,53 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+enum class TaskPriority
+{
+    /// Latency-sensitive work that the user is actively waiting on, such as completion or hover
+    Interactive,
+    Normal,
+    /// Bulk work, such as computing diagnostics for the whole workspace
+    Background,
+};
+
+/// A fixed-size pool of worker threads which execute queued tasks in priority order.
+/// Tasks of the same priority are executed in FIFO order
+class WorkerPool
+{
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkerPool(size_t threadCount = defaultThreadCount());
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /// Queues a task to be executed on the next available worker
+    void push(Task task, TaskPriority priority = TaskPriority::Normal);
+    /// Queues a task to be executed once the delay has elapsed. Delayed tasks which are not yet due when the pool is destroyed are abandoned
+    void pushAfter(std::chrono::steady_clock::duration delay, Task task, TaskPriority priority = TaskPriority::Normal);
+
+    /// The number of workers to use when none is specified. Based off the hardware concurrency
+    static size_t defaultThreadCount();
+
+private:
+    void workerLoop();
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    /// A queue of tasks for each priority level, indexed by TaskPriority
+    std::array<std::queue<Task>, 3> tasks;
+    /// Tasks which are not yet due, ordered by the time they become due
+    std::multimap<std::chrono::steady_clock::time_point, std::pair<TaskPriority, Task>> delayedTasks;
+    std::vector<std::thread> workers;
+    bool stopping = false;
+};
@@ -1,13 +1,24 @@
 #pragma once
 #include <iostream>
 #include <climits>
+#include <mutex>
+#include <unordered_set>
 #include "Luau/Frontend.h"
 #include "Protocol/Structures.hpp"
 #include "Protocol/LanguageFeatures.hpp"
 #include "Protocol/SignatureHelp.hpp"
 #include "Protocol/SemanticTokens.hpp"
 #include "LSP/Client.hpp"
+#include "LSP/Cancellation.hpp"
 #include "LSP/WorkspaceFileResolver.hpp"
+#include "LSP/DiagnosticsCache.hpp"
+#include "LSP/FileInventory.hpp"
+#include "LSP/GlobMatcher.hpp"
+#include "LSP/ReverseDependencyIndex.hpp"
+#include "LSP/ReferenceIndex.hpp"
+#include "LSP/CallGraphIndex.hpp"
+#include "LSP/SymbolIndex.hpp"
+#include "LSP/WorkerPool.hpp"
 
 struct Reference
 {
@@ -30,6 +41,8 @@ public:
     Luau::Frontend frontend;
     bool isConfigured = false;
     Luau::TypeArena instanceTypes;
+    /// The source files in the workspace. Kept up to date using `workspace/didChangeWatchedFiles` notifications
+    FileInventory fileInventory;
 
 public:
     WorkspaceFolder(
@@ -43,6 +56,7 @@ public:
         // when calling Luau::autocomplete
         , frontend(Luau::Frontend(
               &fileResolver, &fileResolver, {/* retainFullTypeGraphs: */ true, /* forAutocomplete: */ false, /* runLintChecks: */ false}))
+        , fileInventory(uri.fsPath())
     {
         fileResolver.client = std::static_pointer_cast<BaseClient>(client);
         fileResolver.rootUri = uri;
@@ -59,57 +73,149 @@ public:
         const lsp::DocumentUri& uri, const lsp::DidChangeTextDocumentParams& params, std::vector<Luau::ModuleName>* markedDirty = nullptr);
     void closeTextDocument(const lsp::DocumentUri& uri);
 
+    /// Marks the module and its dependents as dirty in the frontend. This should be used rather than `frontend.markDirty`,
+    /// so that the reverse dependency index is updated once the modules are re-parsed
+    void markDirty(const Luau::ModuleName& moduleName, std::vector<Luau::ModuleName>* markedDirty = nullptr);
+
     /// Whether the file has been marked as ignored by any of the ignored lists in the configuration
-    bool isIgnoredFile(const std::filesystem::path& path, const std::optional<ClientConfiguration>& givenConfig = std::nullopt);
+    bool isIgnoredFile(const std::filesystem::path& path);
+    bool isIgnoredFile(const std::filesystem::path& path, const ClientConfiguration& config);
     /// Whether the file has been specified in the configuration as a definitions file
-    bool isDefinitionFile(const std::filesystem::path& path, const std::optional<ClientConfiguration>& givenConfig = std::nullopt);
-
-    lsp::DocumentDiagnosticReport documentDiagnostics(const lsp::DocumentDiagnosticParams& params);
-    lsp::WorkspaceDiagnosticReport workspaceDiagnostics(const lsp::WorkspaceDiagnosticParams& params);
+    bool isDefinitionFile(const std::filesystem::path& path);
+    bool isDefinitionFile(const std::filesystem::path& path, const ClientConfiguration& config);
+    /// Whether the path is outside of the workspace, or within a directory which is hidden (e.g. `.git`) or in which every file
+    /// is ignored (e.g. `**/node_modules/**`). Changes to such paths cannot add or remove any relevant source files
+    bool isWithinExcludedDirectory(const std::filesystem::path& path, const ClientConfiguration& config);
+    /// Finds all the source files in the workspace, excluding definitions files. Ignored files are only included if `includeIgnored` is true
+    std::vector<std::filesystem::path> findSourceFiles(const ClientConfiguration& config, bool includeIgnored = false);
+
+    lsp::DocumentDiagnosticReport documentDiagnostics(
+        const lsp::DocumentDiagnosticParams& params, const LSPCancellationToken& cancellationToken = nullptr);
+    lsp::WorkspaceDiagnosticReport workspaceDiagnostics(
+        const lsp::WorkspaceDiagnosticParams& params, const LSPCancellationToken& cancellationToken = nullptr);
+    /// Finds all the source files in the workspace which workspace diagnostics should be computed for
+    std::vector<Uri> findWorkspaceDiagnosticsFiles(const ClientConfiguration& config);
+    /// Computes the workspace diagnostics report for a single file. Returns std::nullopt if the file could not be found.
+    /// This allows workspace diagnostics to be computed a module at a time
+    std::optional<lsp::WorkspaceDocumentDiagnosticReport> workspaceDocumentDiagnostics(
+        const Uri& uri, const ClientConfiguration& config, const LSPCancellationToken& cancellationToken = nullptr);
+    /// Computes the workspace diagnostics reports for a set of files. The files are first typechecked in parallel (see `checkSimpleInParallel`)
+    std::vector<lsp::WorkspaceDocumentDiagnosticReport> workspaceDocumentDiagnostics(
+        const std::vector<Uri>& uris, const ClientConfiguration& config, const LSPCancellationToken& cancellationToken = nullptr);
 
     void clearDiagnosticsForFile(const lsp::DocumentUri& uri);
 
     void indexFiles(const ClientConfiguration& config);
 
-    Luau::CheckResult checkSimple(const Luau::ModuleName& moduleName, bool runLintChecks = false);
-    void checkStrict(const Luau::ModuleName& moduleName, bool forAutocomplete = true);
+    Luau::CheckResult checkSimple(
+        const Luau::ModuleName& moduleName, bool runLintChecks = false, const LSPCancellationToken& cancellationToken = nullptr);
+    /// Typechecks the modules and their dependencies across multiple threads, discarding type graphs. A module is checked as soon as all the modules
+    /// it requires have been, so independent parts of the require graph are checked concurrently. A subsequent `checkSimple` of these modules
+    /// (with the same `runLintChecks`) reuses the results
+    void checkSimpleInParallel(
+        const std::vector<Luau::ModuleName>& moduleNames, bool runLintChecks = false, const LSPCancellationToken& cancellationToken = nullptr);
+    void checkStrict(const Luau::ModuleName& moduleName, bool forAutocomplete = true, const LSPCancellationToken& cancellationToken = nullptr);
+    Luau::SourceModule* parseSourceModule(const Luau::ModuleName& moduleName);
+    /// Returns the module and its transitive requires which have not yet been typechecked for autocomplete with their type graphs retained.
+    /// Every module is ordered after the modules it requires, so checking them in order typechecks one new module at a time
+    std::vector<Luau::ModuleName> findUncheckedRequireClosure(const Luau::ModuleName& moduleName);
+
+    /// Writes the diagnostics cache to the cache directory, if it has changed
+    void saveDiagnosticsCache();
 
 private:
+    /// Serialises `frontend.parse` calls made by read-only requests, which may be running concurrently
+    std::mutex parseMutex;
+    /// Runs the tasks handed out by the Frontend in `checkSimpleInParallel`. Created on first use.
+    /// NOTE: separate from the server's worker pool, whose workers may be blocked waiting on the workspace lock held by the check
+    std::unique_ptr<WorkerPool> checkPool = nullptr;
+
+    /// The `ignoreGlobs` the file inventory was built with. Ignored directories are not walked, so the inventory is rebuilt if they change
+    std::vector<std::string> fileInventoryIgnoreGlobs{};
+
+    ReverseDependencyIndex reverseDependencies;
+    /// Modules which have been marked dirty, and so may have different requires once they have been re-parsed.
+    /// Maps to the source module the requires were last read from, so that they are only read again once the module is re-parsed
+    std::unordered_map<Luau::ModuleName, std::weak_ptr<Luau::SourceModule>> pendingReverseDependencyUpdates{};
+
+    /// The property references of each module which has been searched for references
+    ReferenceIndex referenceIndex;
+    /// The checked module each module's references were indexed from. If the module has since been re-checked or marked dirty, it is re-indexed
+    std::unordered_map<Luau::ModuleName, std::weak_ptr<Luau::Module>> indexedReferenceModules{};
+    void updateReferenceIndex(const Luau::ModuleName& moduleName, const LSPCancellationToken& cancellationToken);
+
+    /// The calls made within each module which has been searched for incoming calls
+    CallGraphIndex callGraphIndex;
+    /// The checked module each module's calls were indexed from. If the module has since been re-checked, it is re-indexed
+    std::unordered_map<Luau::ModuleName, std::weak_ptr<Luau::Module>> indexedCallGraphModules{};
+    void updateCallGraphIndex(const Luau::ModuleName& moduleName);
+
+    /// The symbols of every module, for workspace symbol search
+    SymbolIndex symbolIndex;
+    /// The source module each module's symbols were indexed from. If the module has since been re-parsed, it is re-indexed
+    std::unordered_map<Luau::ModuleName, std::weak_ptr<Luau::SourceModule>> indexedSymbolModules{};
+    /// Brings the symbol index up to date with any modules which have changed since it was last updated
+    void updateSymbolIndex();
+
     void endAutocompletion(const lsp::CompletionParams& params);
     void suggestImports(const Luau::ModuleName& moduleName, const Luau::Position& position, const ClientConfiguration& config,
         const TextDocument& textDocument, std::vector<lsp::CompletionItem>& result, bool includeServices = true);
     lsp::WorkspaceEdit computeOrganiseRequiresEdit(const lsp::DocumentUri& uri);
     lsp::WorkspaceEdit computeOrganiseServicesEdit(const lsp::DocumentUri& uri);
+    /// Returns the module, followed by every module which transitively requires it
     std::vector<Luau::ModuleName> findReverseDependencies(const Luau::ModuleName& moduleName);
+    /// Brings the reverse dependency index up to date with the modules which have been parsed since it was last updated
+    void updateReverseDependencies();
+    /// Returns the module and its transitive requires, with every module ordered after the modules it requires
+    std::vector<Luau::ModuleName> findRequireClosure(const Luau::ModuleName& moduleName);
+
+    /// Everything other than the contents of the files which affects how the requires of a module are resolved.
+    /// If this changes, the require graph cache is discarded
+    std::string requireGraphFingerprint(const ClientConfiguration& config);
+    /// A hash of everything which affects the diagnostics of every module, other than the modules themselves:
+    /// the relevant configuration, the definitions files and the Luau FFlags
+    uint64_t diagnosticsCacheFingerprint(const ClientConfiguration& config);
+    /// A hash of everything which affects the diagnostics of the module: the fingerprint, along with the source and Luau configuration
+    /// of the module and each of its transitive requires. Module hashes are memoised in `moduleHashes`
+    uint64_t diagnosticsCacheKey(
+        const Luau::ModuleName& moduleName, uint64_t fingerprint, std::unordered_map<Luau::ModuleName, uint64_t>& moduleHashes);
+
+    /// Diagnostics persisted between sessions. Loaded when workspace diagnostics are first computed, if a cache directory was provided
+    std::optional<DiagnosticsCache> diagnosticsCache = std::nullopt;
+    /// The hash of the definitions files and FFlags, which do not change throughout the session
+    std::optional<uint64_t> definitionsHash = std::nullopt;
 
 public:
     std::vector<std::string> getComments(const Luau::ModuleName& moduleName, const Luau::Location& node);
     std::optional<std::string> getDocumentationForType(const Luau::TypeId ty);
-    std::vector<Reference> findAllReferences(const Luau::TypeId ty, std::optional<Luau::Name> property = std::nullopt);
-    std::vector<Reference> findAllTypeReferences(const Luau::ModuleName& moduleName, const Luau::Name& typeName);
+    std::vector<Reference> findAllReferences(
+        const Luau::TypeId ty, std::optional<Luau::Name> property = std::nullopt, const LSPCancellationToken& cancellationToken = nullptr);
+    std::vector<Reference> findAllTypeReferences(
+        const Luau::ModuleName& moduleName, const Luau::Name& typeName, const LSPCancellationToken& cancellationToken = nullptr);
 
-    std::vector<lsp::CompletionItem> completion(const lsp::CompletionParams& params);
+    std::vector<lsp::CompletionItem> completion(const lsp::CompletionParams& params, const LSPCancellationToken& cancellationToken = nullptr);
 
     std::vector<lsp::DocumentLink> documentLink(const lsp::DocumentLinkParams& params);
     lsp::DocumentColorResult documentColor(const lsp::DocumentColorParams& params);
     lsp::ColorPresentationResult colorPresentation(const lsp::ColorPresentationParams& params);
     lsp::CodeActionResult codeAction(const lsp::CodeActionParams& params);
 
-    std::optional<lsp::Hover> hover(const lsp::HoverParams& params);
+    std::optional<lsp::Hover> hover(const lsp::HoverParams& params, const LSPCancellationToken& cancellationToken = nullptr);
 
-    std::optional<lsp::SignatureHelp> signatureHelp(const lsp::SignatureHelpParams& params);
+    std::optional<lsp::SignatureHelp> signatureHelp(const lsp::SignatureHelpParams& params, const LSPCancellationToken& cancellationToken = nullptr);
 
     lsp::DefinitionResult gotoDefinition(const lsp::DefinitionParams& params);
 
     std::optional<lsp::Location> gotoTypeDefinition(const lsp::TypeDefinitionParams& params);
 
-    lsp::ReferenceResult references(const lsp::ReferenceParams& params);
-    lsp::RenameResult rename(const lsp::RenameParams& params);
+    lsp::ReferenceResult references(const lsp::ReferenceParams& params, const LSPCancellationToken& cancellationToken = nullptr);
+    lsp::RenameResult rename(const lsp::RenameParams& params, const LSPCancellationToken& cancellationToken = nullptr);
     lsp::InlayHintResult inlayHint(const lsp::InlayHintParams& params);
     std::vector<lsp::FoldingRange> foldingRange(const lsp::FoldingRangeParams& params);
 
     std::vector<lsp::CallHierarchyItem> prepareCallHierarchy(const lsp::CallHierarchyPrepareParams& params);
-    std::vector<lsp::CallHierarchyIncomingCall> callHierarchyIncomingCalls(const lsp::CallHierarchyIncomingCallsParams& params);
+    std::vector<lsp::CallHierarchyIncomingCall> callHierarchyIncomingCalls(
+        const lsp::CallHierarchyIncomingCallsParams& params, const LSPCancellationToken& cancellationToken = nullptr);
     std::vector<lsp::CallHierarchyOutgoingCall> callHierarchyOutgoingCalls(const lsp::CallHierarchyOutgoingCallsParams& params);
 
     std::optional<std::vector<lsp::DocumentSymbol>> documentSymbol(const lsp::DocumentSymbolParams& params);
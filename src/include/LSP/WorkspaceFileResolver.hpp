@@ -2,6 +2,7 @@
 #include <optional>
 #include <filesystem>
 #include <unordered_map>
+#include <mutex>
 #include "Luau/FileResolver.h"
 #include "Luau/StringUtils.h"
 #include "Luau/Config.h"
@@ -69,6 +70,14 @@ struct WorkspaceFileResolver
     // Currently opened files where content is managed by client
     mutable std::unordered_map</* DocumentUri */ std::string, TextDocument> managedFiles{};
     mutable std::unordered_map<std::string, Luau::Config> configCache{};
+    /// Guards the config cache, as configs are looked up from within typechecking, which may be running on multiple threads
+    mutable std::mutex configCacheMutex;
+    /// File contents which have already been read in ahead of time (e.g. in parallel whilst indexing), keyed by module name.
+    /// An entry is consumed by the next `readSource` call for that module
+    std::unordered_map<Luau::ModuleName, std::string> preloadedSources{};
+    /// Memoised results of `canonicalPath`. Cleared whenever the sourcemap is updated
+    mutable std::unordered_map<std::string, std::filesystem::path> canonicalPaths{};
+    mutable std::mutex canonicalPathsMutex;
 
     WorkspaceFileResolver()
     {
@@ -100,6 +109,10 @@ struct WorkspaceFileResolver
     // We first try and find a virtual file path which matches it, and return that. Otherwise, we use the file system path
     Luau::ModuleName getModuleName(const Uri& name);
 
+    /// The weakly canonical form of the path, or the path itself if it could not be canonicalised.
+    /// Results are memoised, as canonicalising a path requires a filesystem call for each of its components
+    std::filesystem::path canonicalPath(const std::filesystem::path& path) const;
+
     std::optional<SourceNodePtr> getSourceNodeFromVirtualPath(const Luau::ModuleName& name) const;
 
     std::optional<SourceNodePtr> getSourceNodeFromRealPath(const std::string& name) const;
@@ -12,7 +12,8 @@ LUAU_FASTINT(LuauTarjanChildLimit)
 enum class CliMode
 {
     Lsp,
-    Analyze
+    Analyze,
+    Replay
 };
 
 /// Validate to ensure the flag is correct
@@ -40,6 +41,16 @@ static bool validateFlag(char* str, int argIndex)
         return true;
     else if (strncmp(str, "--settings=", 11) == 0 && n > 12)
         return true;
+    else if (strncmp(str, "--stats-file=", 13) == 0 && n > 14)
+        return true;
+    else if (strncmp(str, "--record=", 9) == 0 && n > 10)
+        return true;
+    else if (strncmp(str, "--cache-dir=", 12) == 0 && n > 13)
+        return true;
+    else if (strncmp(str, "--workspace=", 12) == 0 && n > 13)
+        return true;
+    else if (strcmp(str, "--realtime") == 0)
+        return true;
     else if (strcmp(str, "--formatter=plain") == 0)
         return true;
     else if (strcmp(str, "--formatter=gnu") == 0)
@@ -64,6 +75,7 @@ static void displayInvalidCommand(const std::string& argv0)
     std::cout << "Invalid command. You must specify a mode to run\n";
     std::cout << "Usage: " + argv0 + " lsp [options]\n";
     std::cout << "Usage: " + argv0 + " analyze [--mode] [options] [file list]\n";
+    std::cout << "Usage: " + argv0 + " replay [options] [session file]\n";
     std::cout << "Run '" + argv0 + " --help' for more information\n";
 }
 
@@ -71,6 +83,7 @@ static void displayHelp(const char* argv0)
 {
     printf("Usage: %s lsp [options]\n", argv0);
     printf("Usage: %s analyze [--mode] [options] [file list]\n", argv0);
+    printf("Usage: %s replay [options] [session file]\n", argv0);
     printf("\n");
     printf("Global commands:\n");
     printf("  %s --help: show this help message\n", argv0);
@@ -98,6 +111,13 @@ static void displayHelp(const char* argv0)
     printf("  --definitions=PATH: path to definition file for global types\n");
     printf("  --docs=PATH: path to documentation file to power Intellisense\n");
     printf("  --base-luaurc=PATH: path to a .luaurc file which acts as the base default configuration\n");
+    printf("  --stats-file=PATH: write per-method latency statistics to the file as JSON when the server exits\n");
+    printf("  --record=PATH: record all messages received from the client to the file, to be used with replay\n");
+    printf("  --cache-dir=PATH: directory to persist caches in between sessions (e.g. the workspace require graph), to speed up startup\n");
+    printf("Replay options:\n");
+    printf("  accepts all LSP options, and replays a session file created with --record, reporting the time taken per request\n");
+    printf("  --workspace=PATH: path to the workspace to replay the session against, if different to the recorded workspace\n");
+    printf("  --realtime: wait between messages for as long as in the recorded session\n");
 }
 
 static void displayFlags()
@@ -165,7 +185,7 @@ void registerFastFlags(std::unordered_map<std::string, std::string>& fastFlags)
     }
 }
 
-int startLanguageServer(int argc, char** argv)
+int startLanguageServer(int argc, char** argv, CliMode mode)
 {
 #ifdef _WIN32
     _setmode(_fileno(stdin), _O_BINARY);
@@ -175,8 +195,13 @@ int startLanguageServer(int argc, char** argv)
     std::vector<std::filesystem::path> definitionsFiles{};
     std::vector<std::filesystem::path> documentationFiles{};
     std::optional<std::filesystem::path> baseLuaurc = std::nullopt;
+    std::optional<std::filesystem::path> statisticsFile = std::nullopt;
+    std::optional<std::filesystem::path> recordFile = std::nullopt;
+    std::optional<std::filesystem::path> sessionFile = std::nullopt;
+    std::optional<std::filesystem::path> cacheDirectory = std::nullopt;
+    ReplayOptions replayOptions{};
 
-    for (int i = 1; i < argc; i++)
+    for (int i = 2; i < argc; i++)
     {
         if (strncmp(argv[i], "--definitions=", 14) == 0)
         {
@@ -190,6 +215,30 @@ int startLanguageServer(int argc, char** argv)
         {
             baseLuaurc = std::filesystem::path(argv[i] + 14);
         }
+        else if (strncmp(argv[i], "--stats-file=", 13) == 0)
+        {
+            statisticsFile = std::filesystem::path(argv[i] + 13);
+        }
+        else if (strncmp(argv[i], "--cache-dir=", 12) == 0)
+        {
+            cacheDirectory = std::filesystem::path(argv[i] + 12);
+        }
+        else if (strncmp(argv[i], "--record=", 9) == 0)
+        {
+            recordFile = std::filesystem::path(argv[i] + 9);
+        }
+        else if (strncmp(argv[i], "--workspace=", 12) == 0)
+        {
+            replayOptions.workspace = std::filesystem::path(argv[i] + 12);
+        }
+        else if (strcmp(argv[i], "--realtime") == 0)
+        {
+            replayOptions.realtime = true;
+        }
+        else if (argv[i][0] != '-')
+        {
+            sessionFile = std::filesystem::path(argv[i]);
+        }
     }
 
     std::optional<Luau::Config> defaultConfig = std::nullopt;
@@ -212,10 +261,47 @@ int startLanguageServer(int argc, char** argv)
         }
     }
 
-    LanguageServer server(definitionsFiles, documentationFiles, defaultConfig);
+    if (mode == CliMode::Replay)
+    {
+        if (!sessionFile)
+        {
+            std::cerr << "No session file provided to replay\n";
+            return 1;
+        }
+
+        std::vector<RecordedMessage> session;
+        try
+        {
+            session = loadRecordedSession(*sessionFile);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+
+        // Responses from the server are not needed during a replay, so they are discarded
+        auto client = std::make_shared<Client>(
+            [](const char*, size_t)
+            {
+                return true;
+            });
+        client->cacheDirectory = cacheDirectory;
+        LanguageServer server(client, definitionsFiles, documentationFiles, defaultConfig, statisticsFile);
+        replaySession(server, std::move(session), replayOptions);
+        server.dumpStatistics();
+        return 0;
+    }
+
+    auto client = std::make_shared<Client>();
+    client->cacheDirectory = cacheDirectory;
+    LanguageServer server(client, definitionsFiles, documentationFiles, defaultConfig, statisticsFile);
+    if (recordFile)
+        server.recordSession(*recordFile);
 
     // Begin input loop
     server.processInputLoop();
+    server.dumpStatistics();
 
     // If we received a shutdown request before exiting, exit normally. Otherwise, it is an abnormal exit
     return server.requestedShutdown() ? 0 : 1;
@@ -255,6 +341,10 @@ int main(int argc, char** argv)
     {
         mode = CliMode::Analyze;
     }
+    else if (strcmp(argv[1], "replay") == 0)
+    {
+        mode = CliMode::Replay;
+    }
     else
     {
         displayInvalidCommand(argv[0]);
@@ -316,8 +406,8 @@ int main(int argc, char** argv)
     if (FInt::LuauTarjanChildLimit > 0 && FInt::LuauTarjanChildLimit < 15000)
         FInt::LuauTarjanChildLimit.value = 15000;
 
-    if (mode == CliMode::Lsp)
-        return startLanguageServer(argc, argv);
+    if (mode == CliMode::Lsp || mode == CliMode::Replay)
+        return startLanguageServer(argc, argv, mode);
     else
         return startAnalyze(argc, argv);
 }
\ No newline at end of file
@@ -27,20 +27,6 @@ static FunctionName getFunctionName(Luau::AstExpr* expr)
     return {name, std::nullopt};
 }
 
-static bool isSameFunction(const Luau::TypeId a, const Luau::TypeId b)
-{
-    if (a == b)
-        return true;
-
-    if (auto ftv1 = Luau::get<Luau::FunctionType>(a))
-        if (auto ftv2 = Luau::get<Luau::FunctionType>(b))
-            return ftv1->definition && ftv2->definition && ftv1->definition->definitionModuleName && ftv2->definition->definitionModuleName &&
-                   ftv1->definition->definitionModuleName == ftv2->definition->definitionModuleName &&
-                   ftv1->definition->definitionLocation == ftv2->definition->definitionLocation;
-
-    return false;
-}
-
 static Luau::TypeId lookupFunctionCallType(Luau::ModulePtr module, const Luau::AstExprCall* call)
 {
     if (auto ty = module->astTypes.find(call->func))
@@ -108,6 +94,57 @@ struct FindAllCallsVisitor : public Luau::AstVisitor
 };
 
 
+// Finds the calls made by each function of the module, and outside of any function, using the types of the last check
+static std::vector<CallGraphIndex::Caller> findCallers(const Luau::SourceModule& sourceModule, const Luau::ModulePtr& module)
+{
+    std::vector<CallGraphIndex::Caller> callers;
+
+    auto addCaller = [&module, &callers](Luau::AstNode* node, CallGraphIndex::Caller caller)
+    {
+        FindAllCallsVisitor callsVisitor(/* ignoreOtherFunctions = */ true);
+        node->visit(&callsVisitor);
+
+        for (const auto& call : callsVisitor.calls)
+            if (auto ty = lookupFunctionCallType(module, call))
+                if (auto ftv = Luau::get<Luau::FunctionType>(ty); ftv && ftv->definition && ftv->definition->definitionModuleName)
+                    caller.calls.emplace_back(
+                        CallGraphIndex::Call{*ftv->definition->definitionModuleName, ftv->definition->definitionLocation, call->func->location});
+
+        if (!caller.calls.empty())
+            callers.emplace_back(std::move(caller));
+    };
+
+    FindAllFunctionsVisitor funcsVisitor;
+    sourceModule.root->visit(&funcsVisitor);
+    for (auto& [funcName, funcLocation, nameLocation, func] : funcsVisitor.funcs)
+        addCaller(func, CallGraphIndex::Caller{funcName.first, funcName.second, std::make_pair(funcLocation, nameLocation), {}});
+
+    // Search the root of the AST to find calls outside of functions
+    addCaller(sourceModule.root, CallGraphIndex::Caller{"<no function>", std::nullopt, std::nullopt, {}});
+
+    return callers;
+}
+
+// Brings the calls recorded for the module up to date. A module is only visited again once it has been re-checked
+void WorkspaceFolder::updateCallGraphIndex(const Luau::ModuleName& moduleName)
+{
+    auto sourceModule = frontend.getSourceModule(moduleName);
+    auto module = frontend.moduleResolverForAutocomplete.getModule(moduleName);
+    if (!sourceModule || !module)
+    {
+        callGraphIndex.remove(moduleName);
+        indexedCallGraphModules.erase(moduleName);
+        return;
+    }
+
+    auto& indexedModule = indexedCallGraphModules[moduleName];
+    if (indexedModule.lock() == module)
+        return;
+
+    callGraphIndex.update(moduleName, findCallers(*sourceModule, module));
+    indexedModule = module;
+}
+
 std::vector<lsp::CallHierarchyItem> WorkspaceFolder::prepareCallHierarchy(const lsp::CallHierarchyPrepareParams& params)
 {
     // TODO: this is largely based off goto definition, maybe DRY?
@@ -203,7 +240,8 @@ std::vector<lsp::CallHierarchyItem> WorkspaceFolder::prepareCallHierarchy(const
         return {};
 }
 
-std::vector<lsp::CallHierarchyIncomingCall> WorkspaceFolder::callHierarchyIncomingCalls(const lsp::CallHierarchyIncomingCallsParams& params)
+std::vector<lsp::CallHierarchyIncomingCall> WorkspaceFolder::callHierarchyIncomingCalls(
+    const lsp::CallHierarchyIncomingCallsParams& params, const LSPCancellationToken& cancellationToken)
 {
     auto moduleName = fileResolver.getModuleName(params.item.uri);
 
@@ -227,7 +265,11 @@ std::vector<lsp::CallHierarchyIncomingCall> WorkspaceFolder::callHierarchyIncomi
     if (!ty)
         return {};
 
-    auto followedTy = Luau::follow(*ty);
+    auto ftv = Luau::get<Luau::FunctionType>(Luau::follow(*ty));
+    if (!ftv || !ftv->definition || !ftv->definition->definitionModuleName)
+        return {};
+    const auto& definitionModuleName = *ftv->definition->definitionModuleName;
+    const auto& definitionLocation = ftv->definition->definitionLocation;
 
     std::vector<lsp::CallHierarchyIncomingCall> result;
 
@@ -237,87 +279,51 @@ std::vector<lsp::CallHierarchyIncomingCall> WorkspaceFolder::callHierarchyIncomi
     // For each module, search for callers
     for (const auto& dependentModuleName : dependents)
     {
-        auto dependentSourceModule = frontend.getSourceModule(dependentModuleName);
-        auto dependentModule = frontend.moduleResolverForAutocomplete.getModule(dependentModuleName);
-        if (!dependentSourceModule || !dependentModule)
+        throwIfCancelled(cancellationToken);
+
+        updateCallGraphIndex(dependentModuleName);
+        auto incomingCalls = callGraphIndex.findIncomingCalls(dependentModuleName, definitionModuleName, definitionLocation);
+        if (incomingCalls.empty())
             continue;
 
-        FindAllFunctionsVisitor funcsVisitor;
-        dependentSourceModule->root->visit(&funcsVisitor);
+        auto refTextDocument = fileResolver.getOrCreateTextDocumentFromModuleName(dependentModuleName);
+        if (!refTextDocument)
+            continue;
 
-        auto findIncomingCalls = [this, followedTy, &dependentModuleName, &dependentModule, &result](Luau::AstNode* node,
-                                     std::optional<FunctionName> funcName, std::optional<std::pair<Luau::Location, Luau::Location>> locations)
+        for (const auto& [caller, locations] : incomingCalls)
         {
-            FindAllCallsVisitor callsVisitor(/* ignoreOtherFunctions = */ true);
-            node->visit(&callsVisitor);
-            if (callsVisitor.calls.empty())
-                return;
-
-            // Check if any of the calls match
-            std::vector<const Luau::AstExprCall*> matchingCalls{};
-            for (const auto& call : callsVisitor.calls)
-                if (auto ty2 = lookupFunctionCallType(dependentModule, call))
-                    if (isSameFunction(ty2, followedTy))
-                        matchingCalls.emplace_back(call);
-
-            if (matchingCalls.empty())
-                return;
-
             lsp::CallHierarchyItem item{};
+            item.name = caller->name;
+            item.detail = caller->detail;
+            item.kind = caller->locations ? lsp::SymbolKind::Function : lsp::SymbolKind::Namespace;
+            item.uri = refTextDocument->uri();
 
-            if (funcName)
+            if (caller->locations)
             {
-                item.name = funcName->first;
-                item.detail = funcName->second;
-                item.kind = lsp::SymbolKind::Function;
+                auto [funcLocation, nameLocation] = caller->locations.value();
+                item.range = {refTextDocument->convertPosition(funcLocation.begin), refTextDocument->convertPosition(funcLocation.end)};
+                item.selectionRange = {refTextDocument->convertPosition(nameLocation.begin), refTextDocument->convertPosition(nameLocation.end)};
             }
             else
             {
-                item.name = "<no function>";
-                item.kind = lsp::SymbolKind::Namespace;
+                item.range = {{0, 0}, {refTextDocument->lineCount() - 1, 0}};
+                item.selectionRange = {{0, 0}, {0, 0}};
             }
 
             std::vector<lsp::Range> convertedRanges{};
-            convertedRanges.reserve(matchingCalls.size());
-
-            if (auto refTextDocument = fileResolver.getOrCreateTextDocumentFromModuleName(dependentModuleName))
-            {
-                item.uri = refTextDocument->uri();
-
-                if (locations)
-                {
-                    auto [funcLocation, nameLocation] = locations.value();
-                    item.range = {refTextDocument->convertPosition(funcLocation.begin), refTextDocument->convertPosition(funcLocation.end)};
-                    item.selectionRange = {refTextDocument->convertPosition(nameLocation.begin), refTextDocument->convertPosition(nameLocation.end)};
-                }
-                else
-                {
-                    item.range = {{0, 0}, {refTextDocument->lineCount() - 1, 0}};
-                    item.selectionRange = {{0, 0}, {0, 0}};
-                }
-
-                for (const auto& call : matchingCalls)
-                    convertedRanges.emplace_back(lsp::Range{
-                        refTextDocument->convertPosition(call->func->location.begin), refTextDocument->convertPosition(call->func->location.end)});
-            }
-            else
-                return;
+            convertedRanges.reserve(locations.size());
+            for (const auto& location : locations)
+                convertedRanges.emplace_back(
+                    lsp::Range{refTextDocument->convertPosition(location.begin), refTextDocument->convertPosition(location.end)});
 
             lsp::CallHierarchyIncomingCall incomingCall{item, convertedRanges};
             result.emplace_back(incomingCall);
-        };
-
-        for (auto& [funcName, funcLocation, nameLocation, func] : funcsVisitor.funcs)
-        {
-            findIncomingCalls(func, funcName, std::make_pair(funcLocation, nameLocation));
         }
-
-        // Search the root of the AST to find calls outside of functions
-        findIncomingCalls(dependentSourceModule->root, std::nullopt, std::nullopt);
     }
 
     return result;
 }
+
 std::vector<lsp::CallHierarchyOutgoingCall> WorkspaceFolder::callHierarchyOutgoingCalls(const lsp::CallHierarchyOutgoingCallsParams& params)
 {
     auto moduleName = fileResolver.getModuleName(params.item.uri);
@@ -12,9 +12,7 @@ lsp::WorkspaceEdit WorkspaceFolder::computeOrganiseRequiresEdit(const lsp::Docum
     if (!textDocument)
         throw JsonRpcException(lsp::ErrorCode::RequestFailed, "No managed text document for " + uri.toString());
 
-    frontend.parse(moduleName);
-
-    auto sourceModule = frontend.getSourceModule(moduleName);
+    auto sourceModule = parseSourceModule(moduleName);
     if (!sourceModule)
         return {};
 
@@ -77,9 +75,7 @@ lsp::WorkspaceEdit WorkspaceFolder::computeOrganiseServicesEdit(const lsp::Docum
     if (!textDocument)
         throw JsonRpcException(lsp::ErrorCode::RequestFailed, "No managed text document for " + uri.toString());
 
-    frontend.parse(moduleName);
-
-    auto sourceModule = frontend.getSourceModule(moduleName);
+    auto sourceModule = parseSourceModule(moduleName);
     if (!sourceModule)
         return {};
 
@@ -148,7 +144,7 @@ lsp::CodeActionResult WorkspaceFolder::codeAction(const lsp::CodeActionParams& p
         result.emplace_back(organiseImportsAction);
 
         // If in Roblox mode, add a sort services code action
-        if (config.types.roblox)
+        if (config->types.roblox)
         {
             lsp::CodeAction sortServicesAction;
             sortServicesAction.title = "Sort services";
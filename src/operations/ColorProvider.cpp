@@ -229,7 +229,7 @@ lsp::DocumentColorResult WorkspaceFolder::documentColor(const lsp::DocumentColor
 {
     // Only enabled for Roblox code
     auto config = client->getConfiguration(rootUri);
-    if (!config.types.roblox)
+    if (!config->types.roblox)
         return {};
 
     auto moduleName = fileResolver.getModuleName(params.textDocument.uri);
@@ -237,9 +237,7 @@ lsp::DocumentColorResult WorkspaceFolder::documentColor(const lsp::DocumentColor
     if (!textDocument)
         throw JsonRpcException(lsp::ErrorCode::RequestFailed, "No managed text document for " + params.textDocument.uri.toString());
 
-    frontend.parse(moduleName);
-
-    auto sourceModule = frontend.getSourceModule(moduleName);
+    auto sourceModule = parseSourceModule(moduleName);
     if (!sourceModule)
         return {};
 
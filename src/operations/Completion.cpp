@@ -65,9 +65,7 @@ void WorkspaceFolder::endAutocompletion(const lsp::CompletionParams& params)
         return;
     auto position = document->convertPosition(params.position);
 
-    frontend.parse(moduleName);
-
-    auto sourceModule = frontend.getSourceModule(moduleName);
+    auto sourceModule = parseSourceModule(moduleName);
     if (!sourceModule)
         return;
 
@@ -445,16 +443,16 @@ static bool canUseSnippets(const lsp::ClientCapabilities& capabilities)
            capabilities.textDocument->completion->completionItem->snippetSupport;
 }
 
-std::vector<lsp::CompletionItem> WorkspaceFolder::completion(const lsp::CompletionParams& params)
+std::vector<lsp::CompletionItem> WorkspaceFolder::completion(const lsp::CompletionParams& params, const LSPCancellationToken& cancellationToken)
 {
     auto config = client->getConfiguration(rootUri);
 
-    if (!config.completion.enabled)
+    if (!config->completion.enabled)
         return {};
 
     if (params.context && params.context->triggerCharacter == "\n")
     {
-        if (config.autocompleteEnd || config.completion.autocompleteEnd)
+        if (config->autocompleteEnd || config->completion.autocompleteEnd)
             endAutocompletion(params);
         return {};
     }
@@ -466,6 +464,9 @@ std::vector<lsp::CompletionItem> WorkspaceFolder::completion(const lsp::Completi
 
     bool isGetService = false;
 
+    // Luau::autocomplete runs the typechecker, so bail out beforehand if the request has been superseded
+    throwIfCancelled(cancellationToken);
+
     auto position = textDocument->convertPosition(params.position);
     auto result = Luau::autocomplete(frontend, moduleName, position,
         [&](const std::string& tag, std::optional<const Luau::ClassType*> ctx,
@@ -550,7 +551,7 @@ std::vector<lsp::CompletionItem> WorkspaceFolder::completion(const lsp::Completi
                     contentsString = contentsString.substr(0, separator + 1);
 
                 // Populate with custom file aliases
-                for (const auto& [aliasName, _] : config.require.fileAliases)
+                for (const auto& [aliasName, _] : config->require.fileAliases)
                 {
                     Luau::AutocompleteEntry entry{
                         Luau::AutocompleteEntryKind::String, frontend.builtinTypes->stringType, false, false, Luau::TypeCorrectKind::Correct};
@@ -562,7 +563,7 @@ std::vector<lsp::CompletionItem> WorkspaceFolder::completion(const lsp::Completi
                 // Populate with custom directory aliases, if we are at the start of a string require
                 if (contentsString == "")
                 {
-                    for (const auto& [aliasName, _] : config.require.directoryAliases)
+                    for (const auto& [aliasName, _] : config->require.directoryAliases)
                     {
                         Luau::AutocompleteEntry entry{
                             Luau::AutocompleteEntryKind::String, frontend.builtinTypes->stringType, false, false, Luau::TypeCorrectKind::Correct};
@@ -574,7 +575,7 @@ std::vector<lsp::CompletionItem> WorkspaceFolder::completion(const lsp::Completi
 
                 // Check if it starts with a directory alias, otherwise resolve with require base path
                 std::filesystem::path currentDirectory =
-                    resolveDirectoryAlias(config.require.directoryAliases, contentsString, /* includeExtension = */ false)
+                    resolveDirectoryAlias(config->require.directoryAliases, contentsString, /* includeExtension = */ false)
                         .value_or(fileResolver.getRequireBasePath(moduleName).append(contentsString));
 
                 try
@@ -723,7 +724,7 @@ std::vector<lsp::CompletionItem> WorkspaceFolder::completion(const lsp::Completi
         }
 
         // Handle parentheses suggestions
-        if (config.completion.addParentheses)
+        if (config->completion.addParentheses)
         {
             if (canUseSnippets(client->capabilities))
             {
@@ -737,7 +738,7 @@ std::vector<lsp::CompletionItem> WorkspaceFolder::completion(const lsp::Completi
                 }
                 else if (entry.parens == Luau::ParenthesesRecommendation::CursorInside)
                 {
-                    std::string parenthesesSnippet = config.completion.addTabstopAfterParentheses ? "($1)$0" : "($0)";
+                    std::string parenthesesSnippet = config->completion.addTabstopAfterParentheses ? "($1)$0" : "($0)";
 
                     if (item.textEdit)
                         item.textEdit->newText += parenthesesSnippet;
@@ -826,10 +827,10 @@ std::vector<lsp::CompletionItem> WorkspaceFolder::completion(const lsp::Completi
                 item.labelDetails = {detail};
 
                 // If we had CursorAfter, then the function call would not have any arguments
-                if (canUseSnippets(client->capabilities) && config.completion.addParentheses && config.completion.fillCallArguments &&
+                if (canUseSnippets(client->capabilities) && config->completion.addParentheses && config->completion.fillCallArguments &&
                     entry.parens != Luau::ParenthesesRecommendation::None)
                 {
-                    if (config.completion.addTabstopAfterParentheses)
+                    if (config->completion.addTabstopAfterParentheses)
                         parenthesesSnippet += "$0";
 
                     if (item.textEdit)
@@ -867,11 +868,11 @@ std::vector<lsp::CompletionItem> WorkspaceFolder::completion(const lsp::Completi
         items.emplace_back(item);
     }
 
-    if (config.completion.suggestImports || config.completion.imports.enabled)
+    if (config->completion.suggestImports || config->completion.imports.enabled)
     {
         if (result.context == Luau::AutocompleteContext::Expression || result.context == Luau::AutocompleteContext::Statement)
         {
-            suggestImports(moduleName, position, config, *textDocument, items, /* includeServices: */ true);
+            suggestImports(moduleName, position, *config, *textDocument, items, /* includeServices: */ true);
         }
         else if (result.context == Luau::AutocompleteContext::Type)
         {
@@ -879,15 +880,15 @@ std::vector<lsp::CompletionItem> WorkspaceFolder::completion(const lsp::Completi
             if (auto node = result.ancestry.back())
                 if (auto typeReference = node->as<Luau::AstTypeReference>())
                     if (!typeReference->prefix)
-                        suggestImports(moduleName, position, config, *textDocument, items, /* includeServices: */ false);
+                        suggestImports(moduleName, position, *config, *textDocument, items, /* includeServices: */ false);
         }
     }
 
     return items;
 }
 
-std::vector<lsp::CompletionItem> LanguageServer::completion(const lsp::CompletionParams& params)
+std::vector<lsp::CompletionItem> LanguageServer::completion(const lsp::CompletionParams& params, const LSPCancellationToken& cancellationToken)
 {
     auto workspace = findWorkspace(params.textDocument.uri);
-    return workspace->completion(params);
+    return workspace->completion(params, cancellationToken);
 }
@@ -2,8 +2,12 @@
 #include "LSP/LanguageServer.hpp"
 #include "LSP/Client.hpp"
 #include "LSP/LuauExt.hpp"
+#include "LSP/Utils.hpp"
 
-lsp::DocumentDiagnosticReport WorkspaceFolder::documentDiagnostics(const lsp::DocumentDiagnosticParams& params)
+#include <algorithm>
+
+lsp::DocumentDiagnosticReport WorkspaceFolder::documentDiagnostics(
+    const lsp::DocumentDiagnosticParams& params, const LSPCancellationToken& cancellationToken)
 {
     if (!isConfigured)
     {
@@ -21,7 +25,7 @@ lsp::DocumentDiagnosticReport WorkspaceFolder::documentDiagnostics(const lsp::Do
         return report; // Bail early with empty report - file was likely closed
 
     // Check the module. We do not need to store the type graphs
-    Luau::CheckResult cr = checkSimple(moduleName, /* runLintChecks: */ true);
+    Luau::CheckResult cr = checkSimple(moduleName, /* runLintChecks: */ true, cancellationToken);
 
     // If there was an error retrieving the source module
     // Bail early with an empty report - it is likely that the file was closed
@@ -31,7 +35,7 @@ lsp::DocumentDiagnosticReport WorkspaceFolder::documentDiagnostics(const lsp::Do
     auto config = client->getConfiguration(rootUri);
 
     // If the file is a definitions file, then don't display any diagnostics
-    if (isDefinitionFile(params.textDocument.uri.fsPath(), config))
+    if (isDefinitionFile(params.textDocument.uri.fsPath(), *config))
         return report;
 
     // Report Type Errors
@@ -46,7 +50,7 @@ lsp::DocumentDiagnosticReport WorkspaceFolder::documentDiagnostics(const lsp::Do
         else
         {
             auto fileName = fileResolver.resolveToRealPath(error.moduleName);
-            if (!fileName || isIgnoredFile(*fileName, config))
+            if (!fileName || isIgnoredFile(*fileName, *config))
                 continue;
             auto textDocument = fileResolver.getTextDocumentFromModuleName(error.moduleName);
             auto diagnostic = createTypeErrorDiagnostic(error, &fileResolver, textDocument);
@@ -81,113 +85,320 @@ lsp::DocumentDiagnosticReport WorkspaceFolder::documentDiagnostics(const lsp::Do
     return report;
 }
 
-lsp::WorkspaceDiagnosticReport WorkspaceFolder::workspaceDiagnostics(const lsp::WorkspaceDiagnosticParams& params)
+std::vector<Uri> WorkspaceFolder::findWorkspaceDiagnosticsFiles(const ClientConfiguration& config)
 {
-    lsp::WorkspaceDiagnosticReport workspaceReport;
-
     // Don't compute any workspace diagnostics for null workspace
     if (isNullWorkspace())
-        return workspaceReport;
-
-    auto config = client->getConfiguration(rootUri);
+        return {};
 
-    // Find a list of files to compute diagnostics for
+    // Ignored files are included, so that any diagnostics previously reported for them are cleared
     std::vector<Uri> files{};
-    for (std::filesystem::recursive_directory_iterator next(this->rootUri.fsPath()), end; next != end; ++next)
+    for (const auto& path : findSourceFiles(config, /* includeIgnored: */ true))
+        files.push_back(Uri::file(path));
+
+    return files;
+}
+
+std::optional<lsp::WorkspaceDocumentDiagnosticReport> WorkspaceFolder::workspaceDocumentDiagnostics(
+    const Uri& uri, const ClientConfiguration& config, const LSPCancellationToken& cancellationToken)
+{
+    auto moduleName = fileResolver.getModuleName(uri);
+    auto document = fileResolver.getTextDocument(uri);
+
+    lsp::WorkspaceDocumentDiagnosticReport documentReport;
+    documentReport.uri = uri;
+    documentReport.kind = lsp::DocumentDiagnosticReportKind::Full;
+    if (document)
+        documentReport.version = document->version();
+
+    // If we don't have workspace diagnostics enabled, or we are are ignoring this file
+    // Then provide an empty report to clear the file diagnostics
+    if (!config.diagnostics.workspace || isIgnoredFile(uri, config))
+        return documentReport;
+
+    // Compute new check result
+    Luau::CheckResult cr = checkSimple(moduleName, /* runLintChecks: */ true, cancellationToken);
+
+    // If there was an error retrieving the source module, disregard this file
+    // TODO: should we file a diagnostic?
+    if (!frontend.getSourceModule(moduleName))
+        return std::nullopt;
+
+    // Report Type Errors
+    // Only report errors for the current file
+    for (auto& error : cr.errors)
     {
-        if (next->is_regular_file() && next->path().has_extension() && !isDefinitionFile(next->path(), config))
+        if (error.moduleName == moduleName)
         {
-            auto ext = next->path().extension();
-            if (ext == ".lua" || ext == ".luau")
-                files.push_back(Uri::file(next->path()));
+            auto diagnostic = createTypeErrorDiagnostic(error, &fileResolver, document);
+            documentReport.items.emplace_back(diagnostic);
         }
     }
 
-    for (auto uri : files)
+    // Report Lint Warnings
+    for (auto& error : cr.lintResult.errors)
+    {
+        auto diagnostic = createLintDiagnostic(error, document);
+        diagnostic.severity = lsp::DiagnosticSeverity::Error; // Report this as an error instead
+        documentReport.items.emplace_back(diagnostic);
+    }
+    for (auto& error : cr.lintResult.warnings)
+        documentReport.items.emplace_back(createLintDiagnostic(error, document));
+
+    return documentReport;
+}
+
+uint64_t WorkspaceFolder::diagnosticsCacheFingerprint(const ClientConfiguration& config)
+{
+    if (!definitionsHash)
+    {
+        uint64_t hash = client->definitions.hash;
+
+        for (Luau::FValue<bool>* flag = Luau::FValue<bool>::list; flag; flag = flag->next)
+            hash = hashString(std::string(flag->name) + (flag->value ? "=true" : "=false"), hash);
+        for (Luau::FValue<int>* flag = Luau::FValue<int>::list; flag; flag = flag->next)
+            hash = hashString(std::string(flag->name) + "=" + std::to_string(flag->value), hash);
+
+        definitionsHash = hash;
+    }
+
+    // Only the configuration which affects diagnostics is included, so that changing any other setting keeps the cache intact
+    json relevantConfig = {{"diagnostics", config.diagnostics}, {"types", config.types}, {"requireGraph", requireGraphFingerprint(config)}};
+    return hashString(relevantConfig.dump(), *definitionsHash);
+}
+
+uint64_t WorkspaceFolder::diagnosticsCacheKey(
+    const Luau::ModuleName& moduleName, uint64_t fingerprint, std::unordered_map<Luau::ModuleName, uint64_t>& moduleHashes)
+{
+    auto closure = findRequireClosure(moduleName);
+    std::sort(closure.begin(), closure.end());
+
+    uint64_t key = fingerprint;
+    for (const auto& name : closure)
     {
-        auto moduleName = fileResolver.getModuleName(uri);
-        auto document = fileResolver.getTextDocument(uri);
-
-        lsp::WorkspaceDocumentDiagnosticReport documentReport;
-        documentReport.uri = uri;
-        documentReport.kind = lsp::DocumentDiagnosticReportKind::Full;
-        if (document)
-            documentReport.version = document->version();
-
-        // If we don't have workspace diagnostics enabled, or we are are ignoring this file
-        // Then provide an empty report to clear the file diagnostics
-        if (!config.diagnostics.workspace || isIgnoredFile(uri, config))
+        auto it = moduleHashes.find(name);
+        if (it == moduleHashes.end())
         {
-            workspaceReport.items.emplace_back(documentReport);
-            continue;
+            uint64_t hash = hashString(name);
+            if (auto source = fileResolver.readSource(name))
+                hash = hashString(source->source, hash);
+
+            const auto& luauConfig = fileResolver.getConfig(name);
+            hash = hashString(std::to_string(static_cast<int>(luauConfig.mode)) + ":" + std::to_string(luauConfig.enabledLint.warningMask) + ":" +
+                                  std::to_string(luauConfig.fatalLint.warningMask) + ":" + std::to_string(luauConfig.lintErrors) + ":" +
+                                  std::to_string(luauConfig.typeErrors),
+                hash);
+            for (const auto& global : luauConfig.globals)
+                hash = hashString(global, hash);
+
+            it = moduleHashes.emplace(name, hash).first;
         }
 
-        // Compute new check result
-        Luau::CheckResult cr = checkSimple(moduleName, /* runLintChecks: */ true);
+        key = hashString(std::to_string(it->second), key);
+    }
+
+    return key;
+}
+
+void WorkspaceFolder::saveDiagnosticsCache()
+{
+    if (!client->cacheDirectory || !diagnosticsCache || !diagnosticsCache->isModified())
+        return;
+
+    auto path = DiagnosticsCache::pathForWorkspace(*client->cacheDirectory, rootUri.toString());
+    if (!diagnosticsCache->save(path))
+        client->sendLogMessage(lsp::MessageType::Warning, "Failed to write diagnostics cache to " + path.generic_string());
+}
+
+std::vector<lsp::WorkspaceDocumentDiagnosticReport> WorkspaceFolder::workspaceDocumentDiagnostics(
+    const std::vector<Uri>& uris, const ClientConfiguration& config, const LSPCancellationToken& cancellationToken)
+{
+    if (client->cacheDirectory && !diagnosticsCache)
+        diagnosticsCache = DiagnosticsCache::load(DiagnosticsCache::pathForWorkspace(*client->cacheDirectory, rootUri.toString()));
 
-        // If there was an error retrieving the source module, disregard this file
-        // TODO: should we file a diagnostic?
-        if (!frontend.getSourceModule(moduleName))
-            continue;
+    // Files whose inputs have not changed since their diagnostics were cached are not typechecked again
+    std::vector<std::optional<lsp::WorkspaceDocumentDiagnosticReport>> cachedReports(uris.size());
+    std::vector<std::optional<uint64_t>> cacheKeys(uris.size());
 
-        // Report Type Errors
-        // Only report errors for the current file
-        for (auto& error : cr.errors)
+    // Typecheck all the remaining files up-front, so that computing each of their reports reuses the check results
+    if (config.diagnostics.workspace)
+    {
+        std::optional<uint64_t> fingerprint = std::nullopt;
+        std::unordered_map<Luau::ModuleName, uint64_t> moduleHashes;
+
+        std::vector<Luau::ModuleName> moduleNames;
+        for (size_t i = 0; i < uris.size(); i++)
         {
-            if (error.moduleName == moduleName)
+            const auto& uri = uris[i];
+            if (isIgnoredFile(uri.fsPath(), config))
+                continue;
+
+            auto moduleName = fileResolver.getModuleName(uri);
+            if (diagnosticsCache)
             {
-                auto diagnostic = createTypeErrorDiagnostic(error, &fileResolver, document);
-                documentReport.items.emplace_back(diagnostic);
+                if (!fingerprint)
+                    fingerprint = diagnosticsCacheFingerprint(config);
+
+                cacheKeys[i] = diagnosticsCacheKey(moduleName, *fingerprint, moduleHashes);
+                if (auto diagnostics = diagnosticsCache->find(uri.toString(), *cacheKeys[i]))
+                {
+                    lsp::WorkspaceDocumentDiagnosticReport documentReport;
+                    documentReport.uri = uri;
+                    documentReport.kind = lsp::DocumentDiagnosticReportKind::Full;
+                    if (auto document = fileResolver.getTextDocument(uri))
+                        documentReport.version = document->version();
+                    documentReport.items = diagnostics->get<std::vector<lsp::Diagnostic>>();
+                    cachedReports[i] = std::move(documentReport);
+                    continue;
+                }
             }
+
+            moduleNames.push_back(moduleName);
         }
+        checkSimpleInParallel(moduleNames, /* runLintChecks: */ true, cancellationToken);
+    }
 
-        // Report Lint Warnings
-        for (auto& error : cr.lintResult.errors)
+    std::vector<lsp::WorkspaceDocumentDiagnosticReport> reports;
+    for (size_t i = 0; i < uris.size(); i++)
+    {
+        throwIfCancelled(cancellationToken);
+
+        if (cachedReports[i])
         {
-            auto diagnostic = createLintDiagnostic(error, document);
-            diagnostic.severity = lsp::DiagnosticSeverity::Error; // Report this as an error instead
-            documentReport.items.emplace_back(diagnostic);
+            reports.emplace_back(std::move(*cachedReports[i]));
+        }
+        else if (auto documentReport = workspaceDocumentDiagnostics(uris[i], config, cancellationToken))
+        {
+            if (cacheKeys[i])
+                diagnosticsCache->insert(uris[i].toString(), *cacheKeys[i], documentReport->items);
+            reports.emplace_back(std::move(*documentReport));
         }
-        for (auto& error : cr.lintResult.warnings)
-            documentReport.items.emplace_back(createLintDiagnostic(error, document));
-
-        workspaceReport.items.emplace_back(documentReport);
     }
 
+    return reports;
+}
+
+lsp::WorkspaceDiagnosticReport WorkspaceFolder::workspaceDiagnostics(
+    const lsp::WorkspaceDiagnosticParams& params, const LSPCancellationToken& cancellationToken)
+{
+    auto config = client->getConfiguration(rootUri);
+    lsp::WorkspaceDiagnosticReport workspaceReport{workspaceDocumentDiagnostics(findWorkspaceDiagnosticsFiles(*config), *config, cancellationToken)};
+    saveDiagnosticsCache();
     return workspaceReport;
 }
 
-lsp::DocumentDiagnosticReport LanguageServer::documentDiagnostic(const lsp::DocumentDiagnosticParams& params)
+lsp::DocumentDiagnosticReport LanguageServer::documentDiagnostic(
+    const lsp::DocumentDiagnosticParams& params, const LSPCancellationToken& cancellationToken)
 {
     auto workspace = findWorkspace(params.textDocument.uri);
-    return workspace->documentDiagnostics(params);
+    return workspace->documentDiagnostics(params, cancellationToken);
 }
 
-lsp::PartialResponse<lsp::WorkspaceDiagnosticReport> LanguageServer::workspaceDiagnostic(const lsp::WorkspaceDiagnosticParams& params)
+void LanguageServer::workspaceDiagnostic(
+    const id_type& id, const lsp::WorkspaceDiagnosticParams& params, const LSPCancellationToken& cancellationToken)
 {
-    lsp::WorkspaceDiagnosticReport fullReport;
+    // Only a single workspace diagnostics request is serviced at a time, so any previous request is terminated.
+    // If the client supports partial results, each batch is streamed as it is completed. The request is kept open afterwards
+    // to allow streaming of further results
+    client->beginWorkspaceDiagnostics(id, params.partialResultToken);
 
-    for (auto& workspace : workspaceFolders)
+    struct WorkspaceFile
     {
-        auto report = workspace->workspaceDiagnostics(params);
-        fullReport.items.insert(fullReport.items.end(), std::make_move_iterator(report.items.begin()), std::make_move_iterator(report.items.end()));
-    }
+        WorkspaceFolderPtr workspace;
+        ClientConfigurationPtr config;
+        Uri uri;
+    };
 
-    client->workspaceDiagnosticsToken = params.partialResultToken;
-    if (params.partialResultToken)
+    std::vector<WorkspaceFile> files;
+    for (auto& workspace : workspaceFolders)
     {
-        // Send the initial report as a partial result, and allow streaming of further results
-        client->sendProgress({params.partialResultToken.value(), fullReport});
-        return std::nullopt;
+        auto config = client->getConfiguration(workspace->rootUri);
+        for (auto& uri : workspace->findWorkspaceDiagnosticsFiles(*config))
+            files.push_back(WorkspaceFile{workspace, config, std::move(uri)});
     }
-    else
+
+    // Check the files which are currently open first, as that is where the user is most likely to be looking
+    auto isOpen = [](const WorkspaceFile& file)
     {
-        return fullReport;
-    }
+        return file.workspace->fileResolver.getTextDocument(file.uri) != nullptr;
+    };
+    auto closedFiles = std::stable_partition(files.begin(), files.end(), isOpen);
+    auto openFilesCount = static_cast<size_t>(closedFiles - files.begin());
+
+    scheduleBackgroundWork(
+        [this, id, params, cancellationToken, files = std::move(files), openFilesCount, fullReport = lsp::WorkspaceDiagnosticReport{},
+            next = size_t(0)]() mutable
+        {
+            // The request has been superseded by a newer request (or cancelled after it completed), and has already been responded to
+            if (!client->isWorkspaceDiagnosticsRequest(id))
+            {
+                releaseCancellationToken(id, cancellationToken);
+                return false;
+            }
+
+            // The token stays registered until the final step, so that the client can cancel the request whilst it is in progress
+            if (cancellationToken && cancellationToken->requested())
+            {
+                client->cancelWorkspaceDiagnostics(id);
+                releaseCancellationToken(id, cancellationToken);
+                return false;
+            }
+
+            if (next < files.size())
+            {
+                // Files are typechecked in parallel a batch at a time. A batch only contains files from a single workspace,
+                // and open files are kept in batches of their own so that their results are sent as soon as possible
+                const auto& workspace = files[next].workspace;
+                const auto& config = files[next].config;
+                bool batchIsOpen = next < openFilesCount;
+                std::vector<Uri> batch;
+                while (next < files.size() && files[next].workspace == workspace && (next < openFilesCount) == batchIsOpen &&
+                       batch.size() < WorkspaceDiagnosticsBatchSize)
+                    batch.push_back(files[next++].uri);
+
+                std::vector<lsp::WorkspaceDocumentDiagnosticReport> reports;
+                try
+                {
+                    reports = workspace->workspaceDocumentDiagnostics(batch, *config, cancellationToken);
+                }
+                catch (const RequestCancelledException&)
+                {
+                    client->cancelWorkspaceDiagnostics(id);
+                    releaseCancellationToken(id, cancellationToken);
+                    return false;
+                }
+                if (params.partialResultToken)
+                {
+                    client->sendProgress({params.partialResultToken.value(), lsp::WorkspaceDiagnosticReportPartialResult{std::move(reports)}});
+                }
+                else
+                {
+                    for (auto& report : reports)
+                        fullReport.items.emplace_back(std::move(report));
+                }
+
+                if (next < files.size())
+                    return true;
+            }
+
+            for (auto& workspace : workspaceFolders)
+                workspace->saveDiagnosticsCache();
+
+            // Once every file has been checked, any later cancellation is handled through the workspace diagnostics request id
+            releaseCancellationToken(id, cancellationToken);
+            if (!params.partialResultToken)
+            {
+                client->sendResponse(id, fullReport);
+                client->finishWorkspaceDiagnostics(id);
+            }
+
+            return false;
+        });
 }
 
 void Client::terminateWorkspaceDiagnostics(bool retriggerRequest)
 {
+    std::unique_lock lock(workspaceDiagnosticsMutex);
     lsp::DiagnosticServerCancellationData cancellationData{retriggerRequest};
 
     if (this->workspaceDiagnosticsRequestId)
@@ -198,4 +409,46 @@ void Client::terminateWorkspaceDiagnostics(bool retriggerRequest)
 
     this->workspaceDiagnosticsRequestId = std::nullopt;
     this->workspaceDiagnosticsToken = std::nullopt;
-}
\ No newline at end of file
+}
+
+void Client::beginWorkspaceDiagnostics(const id_type& id, const std::optional<lsp::ProgressToken>& partialResultToken)
+{
+    terminateWorkspaceDiagnostics(/* retriggerRequest: */ false);
+
+    std::unique_lock lock(workspaceDiagnosticsMutex);
+    this->workspaceDiagnosticsRequestId = id;
+    this->workspaceDiagnosticsToken = partialResultToken;
+}
+
+bool Client::isWorkspaceDiagnosticsRequest(const id_type& id)
+{
+    std::unique_lock lock(workspaceDiagnosticsMutex);
+    return this->workspaceDiagnosticsRequestId == id;
+}
+
+std::optional<lsp::ProgressToken> Client::getWorkspaceDiagnosticsToken()
+{
+    std::unique_lock lock(workspaceDiagnosticsMutex);
+    return this->workspaceDiagnosticsToken;
+}
+
+void Client::cancelWorkspaceDiagnostics(const id_type& id)
+{
+    std::unique_lock lock(workspaceDiagnosticsMutex);
+    if (this->workspaceDiagnosticsRequestId != id)
+        return;
+
+    this->sendError(id, JsonRpcException(lsp::ErrorCode::RequestCancelled, "workspace diagnostics cancelled"));
+    this->workspaceDiagnosticsRequestId = std::nullopt;
+    this->workspaceDiagnosticsToken = std::nullopt;
+}
+
+void Client::finishWorkspaceDiagnostics(const id_type& id)
+{
+    std::unique_lock lock(workspaceDiagnosticsMutex);
+    if (this->workspaceDiagnosticsRequestId != id)
+        return;
+
+    this->workspaceDiagnosticsRequestId = std::nullopt;
+    this->workspaceDiagnosticsToken = std::nullopt;
+}
@@ -35,9 +35,7 @@ std::vector<lsp::DocumentLink> WorkspaceFolder::documentLink(const lsp::Document
     auto moduleName = fileResolver.getModuleName(params.textDocument.uri);
     std::vector<lsp::DocumentLink> result{};
 
-    frontend.parse(moduleName);
-
-    auto sourceModule = frontend.getSourceModule(moduleName);
+    auto sourceModule = parseSourceModule(moduleName);
     if (!sourceModule || !sourceModule->root)
         return {};
 
@@ -95,9 +95,7 @@ std::vector<lsp::FoldingRange> WorkspaceFolder::foldingRange(const lsp::FoldingR
     if (!textDocument)
         throw JsonRpcException(lsp::ErrorCode::RequestFailed, "No managed text document for " + params.textDocument.uri.toString());
 
-    frontend.parse(moduleName);
-
-    auto sourceModule = frontend.getSourceModule(moduleName);
+    auto sourceModule = parseSourceModule(moduleName);
     if (!sourceModule)
         return {};
 
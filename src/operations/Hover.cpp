@@ -12,11 +12,11 @@ struct DocumentationLocation
     Luau::Location location;
 };
 
-std::optional<lsp::Hover> WorkspaceFolder::hover(const lsp::HoverParams& params)
+std::optional<lsp::Hover> WorkspaceFolder::hover(const lsp::HoverParams& params, const LSPCancellationToken& cancellationToken)
 {
     auto config = client->getConfiguration(rootUri);
 
-    if (!config.hover.enabled)
+    if (!config->hover.enabled)
         return std::nullopt;
 
     auto moduleName = fileResolver.getModuleName(params.textDocument.uri);
@@ -28,10 +28,10 @@ std::optional<lsp::Hover> WorkspaceFolder::hover(const lsp::HoverParams& params)
 
     // Run the type checker to ensure we are up to date
     // TODO: expressiveTypes - remove "forAutocomplete" once the types have been fixed
-    checkStrict(moduleName, /* forAutocomplete: */ config.hover.strictDatamodelTypes);
+    checkStrict(moduleName, /* forAutocomplete: */ config->hover.strictDatamodelTypes, cancellationToken);
 
     auto sourceModule = frontend.getSourceModule(moduleName);
-    auto module = config.hover.strictDatamodelTypes ? frontend.moduleResolverForAutocomplete.getModule(moduleName)
+    auto module = config->hover.strictDatamodelTypes ? frontend.moduleResolverForAutocomplete.getModule(moduleName)
                                                     : frontend.moduleResolver.getModule(moduleName);
     if (!sourceModule)
         return std::nullopt;
@@ -159,7 +159,7 @@ std::optional<lsp::Hover> WorkspaceFolder::hover(const lsp::HoverParams& params)
     opts.useLineBreaks = true;
     opts.functionTypeArguments = true;
     opts.hideNamedFunctionTypeParameters = false;
-    opts.hideTableKind = !config.hover.showTableKinds;
+    opts.hideTableKind = !config->hover.showTableKinds;
     opts.scope = scope;
     std::string typeString = Luau::toString(*type, opts);
 
@@ -177,8 +177,8 @@ std::optional<lsp::Hover> WorkspaceFolder::hover(const lsp::HoverParams& params)
             name = expr;
 
         types::ToStringNamedFunctionOpts funcOpts;
-        funcOpts.hideTableKind = !config.hover.showTableKinds;
-        funcOpts.multiline = config.hover.multilineFunctionDefinitions;
+        funcOpts.hideTableKind = !config->hover.showTableKinds;
+        funcOpts.multiline = config->hover.multilineFunctionDefinitions;
         typeString = codeBlock("lua", types::toStringNamedFunction(module, ftv, name, scope, funcOpts));
     }
     else if (exprOrLocal.getLocal() || node->as<Luau::AstExprLocal>())
@@ -223,8 +223,8 @@ std::optional<lsp::Hover> WorkspaceFolder::hover(const lsp::HoverParams& params)
     return lsp::Hover{{lsp::MarkupKind::Markdown, typeString}};
 }
 
-std::optional<lsp::Hover> LanguageServer::hover(const lsp::HoverParams& params)
+std::optional<lsp::Hover> LanguageServer::hover(const lsp::HoverParams& params, const LSPCancellationToken& cancellationToken)
 {
     auto workspace = findWorkspace(params.textDocument.uri);
-    return workspace->hover(params);
+    return workspace->hover(params, cancellationToken);
 }
\ No newline at end of file
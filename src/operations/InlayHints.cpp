@@ -294,15 +294,15 @@ lsp::InlayHintResult WorkspaceFolder::inlayHint(const lsp::InlayHintParams& para
     std::vector<lsp::DocumentLink> result{};
 
     // TODO: expressiveTypes - remove "forAutocomplete" once the types have been fixed
-    checkStrict(moduleName, /* forAutocomplete: */ config.hover.strictDatamodelTypes);
+    checkStrict(moduleName, /* forAutocomplete: */ config->hover.strictDatamodelTypes);
 
     auto sourceModule = frontend.getSourceModule(moduleName);
-    auto module = config.hover.strictDatamodelTypes ? frontend.moduleResolverForAutocomplete.getModule(moduleName)
+    auto module = config->hover.strictDatamodelTypes ? frontend.moduleResolverForAutocomplete.getModule(moduleName)
                                                     : frontend.moduleResolver.getModule(moduleName);
     if (!sourceModule || !module)
         return {};
 
-    InlayHintVisitor visitor{module, config, textDocument};
+    InlayHintVisitor visitor{module, *config, textDocument};
     visitor.visit(sourceModule->root);
     return visitor.hints;
 }
@@ -20,41 +20,116 @@ static bool isSameTable(const Luau::TypeId a, const Luau::TypeId b)
     return false;
 }
 
-// Find all reverse dependencies of the top-level module
-// NOTE: this function is quite expensive as it requires a BFS
-// TODO: this comes from `markDirty`
-std::vector<Luau::ModuleName> WorkspaceFolder::findReverseDependencies(const Luau::ModuleName& moduleName)
+// Finds every use of a property on a table type within the module, using the types of the last check
+static std::vector<PropertyReference> findPropertyReferences(const Luau::Module& module)
 {
-    std::vector<Luau::ModuleName> dependents{};
-    std::unordered_map<Luau::ModuleName, std::vector<Luau::ModuleName>> reverseDeps;
-    for (const auto& module : frontend.sourceNodes)
+    std::vector<PropertyReference> references;
+    for (const auto [expr, referencedTy] : module.astTypes)
     {
-        for (const auto& dep : module.second->requireSet)
-            reverseDeps[dep].push_back(module.first);
+        if (auto indexName = expr->as<Luau::AstExprIndexName>())
+        {
+            auto possibleParentTy = module.astTypes.find(indexName->expr);
+            if (!possibleParentTy)
+                continue;
+
+            if (auto ttv = Luau::get<Luau::TableType>(Luau::follow(*possibleParentTy)); ttv && !ttv->definitionModuleName.empty())
+                references.push_back(
+                    PropertyReference{ttv->definitionModuleName, ttv->definitionLocation, indexName->index.value, indexName->indexLocation});
+        }
+        else if (auto table = expr->as<Luau::AstExprTable>())
+        {
+            auto ttv = Luau::get<Luau::TableType>(Luau::follow(referencedTy));
+            if (!ttv || ttv->definitionModuleName.empty())
+                continue;
+
+            for (const auto& item : table->items)
+            {
+                if (item.key)
+                {
+                    if (auto propName = item.key->as<Luau::AstExprConstantString>())
+                        references.push_back(PropertyReference{ttv->definitionModuleName, ttv->definitionLocation,
+                            std::string(propName->value.data, propName->value.size), item.key->location});
+                }
+            }
+        }
     }
-    std::vector<Luau::ModuleName> queue{moduleName};
-    while (!queue.empty())
+    return references;
+}
+
+// Brings the property references recorded for the module up to date, typechecking it if it has changed since it was last indexed.
+// Modules which have not changed are not checked again, so their type graphs do not need to be retained
+void WorkspaceFolder::updateReferenceIndex(const Luau::ModuleName& moduleName, const LSPCancellationToken& cancellationToken)
+{
+    auto& indexedModule = indexedReferenceModules[moduleName];
+    auto module = frontend.moduleResolverForAutocomplete.getModule(moduleName);
+    if (module && indexedModule.lock() == module && !frontend.isDirty(moduleName, /* forAutocomplete: */ true))
+        return;
+
+    // Run the typechecker over the module
+    checkStrict(moduleName, /* forAutocomplete: */ true, cancellationToken);
+    module = frontend.moduleResolverForAutocomplete.getModule(moduleName);
+    if (!module)
     {
-        Luau::ModuleName next = std::move(queue.back());
-        queue.pop_back();
+        referenceIndex.remove(moduleName);
+        indexedReferenceModules.erase(moduleName);
+        return;
+    }
 
-        // TODO: maybe do a set-lookup instead?
-        if (contains(dependents, next))
-            continue;
+    referenceIndex.update(moduleName, findPropertyReferences(*module));
+    indexedModule = module;
+}
 
-        dependents.push_back(next);
+void WorkspaceFolder::updateReverseDependencies()
+{
+    // Modules are never removed from the frontend (other than when it is cleared, alongside the index),
+    // so a difference in size means that new modules have been parsed
+    if (frontend.sourceNodes.size() != reverseDependencies.size())
+    {
+        for (const auto& [name, sourceNode] : frontend.sourceNodes)
+            if (!reverseDependencies.contains(name))
+                reverseDependencies.update(name, sourceNode->requireSet);
+    }
 
-        if (0 == reverseDeps.count(next))
+    // The requires of any other module can only change when it is re-parsed after being marked dirty.
+    // Dirty modules are kept pending until they have been re-parsed, but their requires are only read again once
+    // they have a new source module, as re-parsing is the only thing which changes them
+    for (auto it = pendingReverseDependencyUpdates.begin(); it != pendingReverseDependencyUpdates.end();)
+    {
+        auto& [name, readFromModule] = *it;
+        auto sourceNode = frontend.sourceNodes.find(name);
+        if (sourceNode == frontend.sourceNodes.end())
+        {
+            it = pendingReverseDependencyUpdates.erase(it);
             continue;
+        }
 
-        const std::vector<Luau::ModuleName>& dependents = reverseDeps[next];
-        queue.insert(queue.end(), dependents.begin(), dependents.end());
+        std::shared_ptr<Luau::SourceModule> sourceModule = nullptr;
+        if (auto sourceModuleIt = frontend.sourceModules.find(name); sourceModuleIt != frontend.sourceModules.end())
+            sourceModule = sourceModuleIt->second;
+
+        // A module without a source module has never been parsed, so still has the requires it was first indexed with
+        if (sourceModule && readFromModule.lock() != sourceModule)
+        {
+            reverseDependencies.update(name, sourceNode->second->requireSet);
+            readFromModule = sourceModule;
+        }
+
+        if (sourceNode->second->hasDirtySourceModule())
+            ++it;
+        else
+            it = pendingReverseDependencyUpdates.erase(it);
     }
-    return dependents;
+}
+
+std::vector<Luau::ModuleName> WorkspaceFolder::findReverseDependencies(const Luau::ModuleName& moduleName)
+{
+    updateReverseDependencies();
+    return reverseDependencies.findTransitiveDependents(moduleName);
 }
 
 // Find all references across all files for the usage of TableType, or a property on a TableType
-std::vector<Reference> WorkspaceFolder::findAllReferences(Luau::TypeId ty, std::optional<Luau::Name> property)
+std::vector<Reference> WorkspaceFolder::findAllReferences(
+    Luau::TypeId ty, std::optional<Luau::Name> property, const LSPCancellationToken& cancellationToken)
 {
     ty = Luau::follow(ty);
     auto ttv = Luau::get<Luau::TableType>(ty);
@@ -71,44 +146,25 @@ std::vector<Reference> WorkspaceFolder::findAllReferences(Luau::TypeId ty, std::
     // For every module, search for its referencing
     for (const auto& moduleName : dependents)
     {
+        // Property references are answered from the index, which only re-checks modules that have changed since they were indexed
+        if (property)
+        {
+            updateReferenceIndex(moduleName, cancellationToken);
+            for (const auto& location : referenceIndex.find(moduleName, ttv->definitionModuleName, ttv->definitionLocation, *property))
+                references.push_back(Reference{moduleName, location});
+            continue;
+        }
+
         // Run the typechecker over the dependency modules
-        checkStrict(moduleName);
+        checkStrict(moduleName, /* forAutocomplete: */ true, cancellationToken);
         auto module = frontend.moduleResolverForAutocomplete.getModule(moduleName);
         if (!module)
             continue;
 
         for (const auto [expr, referencedTy] : module->astTypes)
         {
-            // If we are looking for a property specifically,
-            // then only look for LuauAstExprIndexName
-            if (property)
-            {
-                if (auto indexName = expr->as<Luau::AstExprIndexName>(); indexName && indexName->index.value == property.value())
-                {
-                    auto possibleParentTy = module->astTypes.find(indexName->expr);
-                    if (possibleParentTy && isSameTable(ty, Luau::follow(*possibleParentTy)))
-                        references.push_back(Reference{moduleName, indexName->indexLocation});
-                }
-                else if (auto table = expr->as<Luau::AstExprTable>(); table && isSameTable(ty, Luau::follow(referencedTy)))
-                {
-                    for (const auto& item : table->items)
-                    {
-                        if (item.key)
-                        {
-                            if (auto propName = item.key->as<Luau::AstExprConstantString>())
-                            {
-                                if (propName->value.data == property.value())
-                                    references.push_back(Reference{moduleName, item.key->location});
-                            }
-                        }
-                    }
-                }
-            }
-            else
-            {
-                if (isSameTable(ty, Luau::follow(referencedTy)))
-                    references.push_back(Reference{moduleName, expr->location});
-            }
+            if (isSameTable(ty, Luau::follow(referencedTy)))
+                references.push_back(Reference{moduleName, expr->location});
         }
     }
 
@@ -127,7 +183,8 @@ std::vector<Reference> WorkspaceFolder::findAllReferences(Luau::TypeId ty, std::
 }
 
 // Find all references of an exported type
-std::vector<Reference> WorkspaceFolder::findAllTypeReferences(const Luau::ModuleName& moduleName, const Luau::Name& typeName)
+std::vector<Reference> WorkspaceFolder::findAllTypeReferences(
+    const Luau::ModuleName& moduleName, const Luau::Name& typeName, const LSPCancellationToken& cancellationToken)
 {
     std::vector<Reference> result;
 
@@ -142,7 +199,7 @@ std::vector<Reference> WorkspaceFolder::findAllTypeReferences(const Luau::Module
         result.emplace_back(Reference{moduleName, location});
 
     // Find the actual declaration location
-    checkStrict(moduleName);
+    checkStrict(moduleName, /* forAutocomplete: */ true, cancellationToken);
     auto module = frontend.moduleResolverForAutocomplete.getModule(moduleName);
     if (!module)
         return {};
@@ -160,7 +217,7 @@ std::vector<Reference> WorkspaceFolder::findAllTypeReferences(const Luau::Module
             continue;
 
         // Run the typechecker over the dependency module
-        checkStrict(dependencyModuleName);
+        checkStrict(dependencyModuleName, /* forAutocomplete: */ true, cancellationToken);
         auto sourceModule = frontend.getSourceModule(dependencyModuleName);
         auto module = frontend.moduleResolverForAutocomplete.getModule(dependencyModuleName);
         if (sourceModule)
@@ -217,7 +274,7 @@ static std::vector<lsp::Location> processReferences(WorkspaceFileResolver& fileR
     return result;
 }
 
-lsp::ReferenceResult WorkspaceFolder::references(const lsp::ReferenceParams& params)
+lsp::ReferenceResult WorkspaceFolder::references(const lsp::ReferenceParams& params, const LSPCancellationToken& cancellationToken)
 {
     auto moduleName = fileResolver.getModuleName(params.textDocument.uri);
     auto textDocument = fileResolver.getTextDocument(params.textDocument.uri);
@@ -228,7 +285,7 @@ lsp::ReferenceResult WorkspaceFolder::references(const lsp::ReferenceParams& par
 
     // Run the type checker to ensure we are up to date
     // We check for autocomplete here since autocomplete has stricter types
-    checkStrict(moduleName);
+    checkStrict(moduleName, /* forAutocomplete: */ true, cancellationToken);
 
     auto sourceModule = frontend.getSourceModule(moduleName);
     if (!sourceModule)
@@ -273,7 +330,7 @@ lsp::ReferenceResult WorkspaceFolder::references(const lsp::ReferenceParams& par
             if (possibleParentTy)
             {
                 auto parentTy = Luau::follow(*possibleParentTy);
-                auto references = findAllReferences(parentTy, indexName->index.value);
+                auto references = findAllReferences(parentTy, indexName->index.value, cancellationToken);
                 return processReferences(fileResolver, references);
             }
         }
@@ -291,7 +348,7 @@ lsp::ReferenceResult WorkspaceFolder::references(const lsp::ReferenceParams& par
             if (auto importedModuleName = module->getModuleScope()->importedModules.find(prefix.value().value);
                 importedModuleName != module->getModuleScope()->importedModules.end())
             {
-                auto references = findAllTypeReferences(importedModuleName->second, reference->name.value);
+                auto references = findAllTypeReferences(importedModuleName->second, reference->name.value, cancellationToken);
                 return processReferences(fileResolver, references);
             }
 
@@ -326,8 +383,8 @@ lsp::ReferenceResult WorkspaceFolder::references(const lsp::ReferenceParams& par
     return std::nullopt;
 }
 
-lsp::ReferenceResult LanguageServer::references(const lsp::ReferenceParams& params)
+lsp::ReferenceResult LanguageServer::references(const lsp::ReferenceParams& params, const LSPCancellationToken& cancellationToken)
 {
     auto workspace = findWorkspace(params.textDocument.uri);
-    return workspace->references(params);
+    return workspace->references(params, cancellationToken);
 }
\ No newline at end of file
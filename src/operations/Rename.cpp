@@ -39,7 +39,7 @@ static void processReferences(
     }
 }
 
-lsp::RenameResult WorkspaceFolder::rename(const lsp::RenameParams& params)
+lsp::RenameResult WorkspaceFolder::rename(const lsp::RenameParams& params, const LSPCancellationToken& cancellationToken)
 {
     // Verify the new name is valid (is an identifier)
     if (params.newName.length() == 0)
@@ -61,7 +61,7 @@ lsp::RenameResult WorkspaceFolder::rename(const lsp::RenameParams& params)
 
     // Run the type checker to ensure we are up to date
     // We check for autocomplete here since autocomplete has stricter types
-    checkStrict(moduleName);
+    checkStrict(moduleName, /* forAutocomplete: */ true, cancellationToken);
 
     auto sourceModule = frontend.getSourceModule(moduleName);
     if (!sourceModule)
@@ -104,7 +104,7 @@ lsp::RenameResult WorkspaceFolder::rename(const lsp::RenameParams& params)
             if (possibleParentTy)
             {
                 auto parentTy = Luau::follow(*possibleParentTy);
-                auto references = findAllReferences(parentTy, indexName->index.value);
+                auto references = findAllReferences(parentTy, indexName->index.value, cancellationToken);
                 processReferences(fileResolver, params.newName, references, result);
                 return result;
             }
@@ -121,7 +121,7 @@ lsp::RenameResult WorkspaceFolder::rename(const lsp::RenameParams& params)
         if (typeDefinition->exported)
         {
             // Type may potentially be used in other files, so we need to handle this globally
-            auto references = findAllTypeReferences(moduleName, typeDefinition->name.value);
+            auto references = findAllTypeReferences(moduleName, typeDefinition->name.value, cancellationToken);
             processReferences(fileResolver, params.newName, references, result);
             return result;
         }
@@ -152,7 +152,7 @@ lsp::RenameResult WorkspaceFolder::rename(const lsp::RenameParams& params)
             if (auto importedModuleName = module->getModuleScope()->importedModules.find(prefix.value().value);
                 importedModuleName != module->getModuleScope()->importedModules.end())
             {
-                auto references = findAllTypeReferences(importedModuleName->second, reference->name.value);
+                auto references = findAllTypeReferences(importedModuleName->second, reference->name.value, cancellationToken);
                 processReferences(fileResolver, params.newName, references, result);
                 return result;
             }
@@ -192,8 +192,8 @@ lsp::RenameResult WorkspaceFolder::rename(const lsp::RenameParams& params)
     throw JsonRpcException(lsp::ErrorCode::RequestFailed, "Unable to find symbol to rename");
 }
 
-lsp::RenameResult LanguageServer::rename(const lsp::RenameParams& params)
+lsp::RenameResult LanguageServer::rename(const lsp::RenameParams& params, const LSPCancellationToken& cancellationToken)
 {
     auto workspace = findWorkspace(params.textDocument.uri);
-    return workspace->rename(params);
+    return workspace->rename(params, cancellationToken);
 }
\ No newline at end of file
@@ -24,11 +24,12 @@ static bool checkOverloadMatch(Luau::TypePackId subTp, Luau::TypePackId superTp,
     return unifier.canUnify(subTp, superTp, /* isFunctionCall = */ true).empty();
 }
 
-std::optional<lsp::SignatureHelp> WorkspaceFolder::signatureHelp(const lsp::SignatureHelpParams& params)
+std::optional<lsp::SignatureHelp> WorkspaceFolder::signatureHelp(
+    const lsp::SignatureHelpParams& params, const LSPCancellationToken& cancellationToken)
 {
     auto config = client->getConfiguration(rootUri);
 
-    if (!config.signatureHelp.enabled)
+    if (!config->signatureHelp.enabled)
         return std::nullopt;
 
     auto moduleName = fileResolver.getModuleName(params.textDocument.uri);
@@ -39,7 +40,7 @@ std::optional<lsp::SignatureHelp> WorkspaceFolder::signatureHelp(const lsp::Sign
 
     // Run the type checker to ensure we are up to date
     // TODO: expressiveTypes - remove "forAutocomplete" once the types have been fixed
-    checkStrict(moduleName);
+    checkStrict(moduleName, /* forAutocomplete: */ true, cancellationToken);
 
     auto sourceModule = frontend.getSourceModule(moduleName);
     if (!sourceModule)
@@ -88,7 +89,7 @@ std::optional<lsp::SignatureHelp> WorkspaceFolder::signatureHelp(const lsp::Sign
     Luau::TypePackId subTp = typeArena.addTypePack(argumentTys, typeArena.freshTypePack(&*scope));
 
     types::ToStringNamedFunctionOpts opts;
-    opts.hideTableKind = !config.hover.showTableKinds;
+    opts.hideTableKind = !config->hover.showTableKinds;
 
     std::optional<size_t> activeSignature = std::nullopt;
     std::vector<lsp::SignatureInformation> signatures{};
@@ -218,8 +219,9 @@ std::optional<lsp::SignatureHelp> WorkspaceFolder::signatureHelp(const lsp::Sign
     return lsp::SignatureHelp{signatures, activeSignature.value_or(0), activeParameter};
 }
 
-std::optional<lsp::SignatureHelp> LanguageServer::signatureHelp(const lsp::SignatureHelpParams& params)
+std::optional<lsp::SignatureHelp> LanguageServer::signatureHelp(
+    const lsp::SignatureHelpParams& params, const LSPCancellationToken& cancellationToken)
 {
     auto workspace = findWorkspace(params.textDocument.uri);
-    return workspace->signatureHelp(params);
+    return workspace->signatureHelp(params, cancellationToken);
 }
\ No newline at end of file
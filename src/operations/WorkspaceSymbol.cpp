@@ -4,30 +4,26 @@
 #include "Luau/Transpiler.h"
 #include "Protocol/LanguageFeatures.hpp"
 #include "LSP/LuauExt.hpp"
+#include "LSP/Statistics.hpp"
+
+/// The maximum number of symbols returned for a query. Clients re-query as more characters are typed,
+/// so only the best matches are needed
+static constexpr size_t MaxWorkspaceSymbols = 256;
 
 struct WorkspaceSymbolsVisitor : public Luau::AstVisitor
 {
     const TextDocument* textDocument;
-    const std::string query;
     std::vector<lsp::WorkspaceSymbol> symbols{};
 
-    explicit WorkspaceSymbolsVisitor(const TextDocument* textDocument, std::string query)
+    explicit WorkspaceSymbolsVisitor(const TextDocument* textDocument)
         : textDocument(textDocument)
-        , query(std::move(toLower(query)))
-    {
-    }
-
-    bool matchesQuery(std::string symbolName)
     {
-        return query.empty() || toLower(symbolName).find(query);
     }
 
     void createLocalSymbol(Luau::AstLocal* local, std::optional<std::string> containerName)
     {
         lsp::WorkspaceSymbol symbol;
         symbol.name = local->name.value;
-        if (!matchesQuery(symbol.name))
-            return;
 
         symbol.kind = lsp::SymbolKind::Variable;
         symbol.location = {
@@ -48,8 +44,6 @@ struct WorkspaceSymbolsVisitor : public Luau::AstVisitor
         lsp::WorkspaceSymbol symbol;
         symbol.name = Luau::toString(function->name);
         trim(symbol.name);
-        if (!matchesQuery(symbol.name))
-            return true;
 
         symbol.kind = function->func->self ? lsp::SymbolKind::Method : lsp::SymbolKind::Function;
         symbol.location = {textDocument->uri(),
@@ -67,8 +61,6 @@ struct WorkspaceSymbolsVisitor : public Luau::AstVisitor
     {
         lsp::WorkspaceSymbol symbol;
         symbol.name = Luau::toString(function->name);
-        if (!matchesQuery(symbol.name))
-            return true;
 
         symbol.kind = function->func->self ? lsp::SymbolKind::Method : lsp::SymbolKind::Function;
         symbol.location = {textDocument->uri(),
@@ -83,8 +75,6 @@ struct WorkspaceSymbolsVisitor : public Luau::AstVisitor
     {
         lsp::WorkspaceSymbol symbol;
         symbol.name = alias->name.value;
-        if (!matchesQuery(symbol.name))
-            return false;
 
         symbol.kind = lsp::SymbolKind::Interface;
         symbol.location = {
@@ -102,35 +92,75 @@ struct WorkspaceSymbolsVisitor : public Luau::AstVisitor
     }
 };
 
-std::optional<std::vector<lsp::WorkspaceSymbol>> WorkspaceFolder::workspaceSymbol(const lsp::WorkspaceSymbolParams& params)
+void WorkspaceFolder::updateSymbolIndex()
 {
-    std::vector<lsp::WorkspaceSymbol> result;
+    // Parse any modules which have changed, or have not been parsed yet (e.g. they were restored from the require graph cache).
+    // Parsing may add further modules to the frontend, so this is done before iterating over the modules
+    std::vector<Luau::ModuleName> dirtyModules;
+    for (const auto& [moduleName, sourceNode] : frontend.sourceNodes)
+        if (sourceNode->hasDirtySourceModule())
+            dirtyModules.push_back(moduleName);
+
+    for (const auto& moduleName : dirtyModules)
+    {
+        ScopedTimer timer(Statistics::Frontend, "parse");
+        frontend.parse(moduleName);
+    }
 
     for (const auto& [moduleName, sourceModule] : frontend.sourceModules)
     {
-        frontend.parse(moduleName);
+        // A module is given a new source module whenever it is re-parsed, so unchanged modules do not need to be visited again
+        auto& indexedModule = indexedSymbolModules[moduleName];
+        if (indexedModule.lock() == sourceModule)
+            continue;
+        indexedModule = sourceModule;
 
         // Find relevant text document
         if (auto textDocument = fileResolver.getTextDocumentFromModuleName(moduleName))
         {
-            WorkspaceSymbolsVisitor visitor{textDocument, params.query};
+            WorkspaceSymbolsVisitor visitor{textDocument};
             visitor.visit(sourceModule->root);
-            result.insert(result.end(), std::make_move_iterator(visitor.symbols.begin()), std::make_move_iterator(visitor.symbols.end()));
+            symbolIndex.update(moduleName, std::move(visitor.symbols));
         }
         else
         {
-            if (auto filePath = fileResolver.resolveToRealPath(moduleName))
+            std::optional<Luau::SourceCode> source = std::nullopt;
+            auto filePath = fileResolver.resolveToRealPath(moduleName);
+            if (filePath)
+                source = fileResolver.readSource(moduleName);
+
+            if (source)
+            {
+                auto textDocument = TextDocument{Uri::file(*filePath), "luau", 0, source->source};
+                WorkspaceSymbolsVisitor visitor{&textDocument};
+                visitor.visit(sourceModule->root);
+                symbolIndex.update(moduleName, std::move(visitor.symbols));
+            }
+            else
             {
-                if (auto source = fileResolver.readSource(moduleName))
-                {
-                    auto textDocument = TextDocument{Uri::file(*filePath), "luau", 0, source->source};
-                    WorkspaceSymbolsVisitor visitor{&textDocument, params.query};
-                    visitor.visit(sourceModule->root);
-                    result.insert(result.end(), std::make_move_iterator(visitor.symbols.begin()), std::make_move_iterator(visitor.symbols.end()));
-                }
+                // The file no longer exists, so any symbols indexed from an earlier version of it are stale
+                symbolIndex.remove(moduleName);
             }
         }
     }
 
-    return result;
-}
\ No newline at end of file
+    // Drop the symbols of modules which have since been removed from the frontend (e.g. their file was deleted)
+    for (auto it = indexedSymbolModules.begin(); it != indexedSymbolModules.end();)
+    {
+        if (it->second.expired() || frontend.sourceModules.find(it->first) == frontend.sourceModules.end())
+        {
+            symbolIndex.remove(it->first);
+            it = indexedSymbolModules.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+std::optional<std::vector<lsp::WorkspaceSymbol>> WorkspaceFolder::workspaceSymbol(const lsp::WorkspaceSymbolParams& params)
+{
+    updateSymbolIndex();
+    return symbolIndex.search(params.query, MaxWorkspaceSymbols);
+}
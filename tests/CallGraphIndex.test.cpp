@@ -0,0 +1,50 @@
+#include "doctest.h"
+#include "LSP/CallGraphIndex.hpp"
+
+static Luau::Location location(unsigned int line, unsigned int column)
+{
+    return Luau::Location{{line, column}, {line, column + 1}};
+}
+
+static CallGraphIndex::Caller caller(const std::string& name, std::vector<CallGraphIndex::Call> calls)
+{
+    return CallGraphIndex::Caller{name, std::nullopt, std::nullopt, std::move(calls)};
+}
+
+TEST_SUITE_BEGIN("CallGraphIndexTests");
+
+TEST_CASE("finds_incoming_calls_grouped_by_caller")
+{
+    CallGraphIndex index;
+    index.update("b", {
+                          caller("first", {{"a", location(0, 0), location(1, 0)}, {"a", location(5, 0), location(2, 0)},
+                                              {"a", location(0, 0), location(3, 0)}}),
+                          caller("second", {{"c", location(0, 0), location(4, 0)}}),
+                          caller("<root>", {{"a", location(0, 0), location(6, 0)}}),
+                      });
+
+    auto calls = index.findIncomingCalls("b", "a", location(0, 0));
+    REQUIRE_EQ(calls.size(), 2);
+    CHECK_EQ(calls[0].first->name, "first");
+    CHECK_EQ(calls[0].second, std::vector<Luau::Location>{location(1, 0), location(3, 0)});
+    CHECK_EQ(calls[1].first->name, "<root>");
+    CHECK_EQ(calls[1].second, std::vector<Luau::Location>{location(6, 0)});
+
+    CHECK(index.findIncomingCalls("b", "c", location(1, 0)).empty());
+    CHECK(index.findIncomingCalls("c", "a", location(0, 0)).empty());
+}
+
+TEST_CASE("updating_a_module_replaces_its_calls")
+{
+    CallGraphIndex index;
+    index.update("b", {caller("first", {{"a", location(0, 0), location(1, 0)}})});
+    index.update("b", {caller("second", {{"c", location(0, 0), location(2, 0)}})});
+
+    CHECK(index.findIncomingCalls("b", "a", location(0, 0)).empty());
+    CHECK_EQ(index.findIncomingCalls("b", "c", location(0, 0)).size(), 1);
+
+    index.remove("b");
+    CHECK_FALSE(index.contains("b"));
+}
+
+TEST_SUITE_END();
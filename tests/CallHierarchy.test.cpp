@@ -0,0 +1,73 @@
+#include "doctest.h"
+#include "Fixture.h"
+
+TEST_SUITE_BEGIN("CallHierarchy");
+
+static std::vector<lsp::CallHierarchyIncomingCall> findIncomingCalls(Fixture& fixture, const lsp::Position& position)
+{
+    lsp::CallHierarchyPrepareParams params;
+    params.textDocument = lsp::TextDocumentIdentifier{Uri("file", "", "MainModule")};
+    params.position = position;
+
+    auto items = fixture.workspace.prepareCallHierarchy(params);
+    REQUIRE_EQ(1, items.size());
+    return fixture.workspace.callHierarchyIncomingCalls(lsp::CallHierarchyIncomingCallsParams{items[0]});
+}
+
+TEST_CASE_FIXTURE(Fixture, "incoming_calls_are_updated_after_the_module_is_edited")
+{
+    auto result = check(R"(
+        local function foo()
+        end
+
+        local function bar()
+            foo()
+        end
+    )");
+    REQUIRE_EQ(0, result.errors.size());
+
+    auto calls = findIncomingCalls(*this, lsp::Position{1, 23});
+    REQUIRE_EQ(1, calls.size());
+    CHECK_EQ(calls[0].from.name, "bar");
+    REQUIRE_EQ(1, calls[0].fromRanges.size());
+    CHECK_EQ(calls[0].fromRanges[0].start.line, 5);
+    CHECK_EQ(calls[0].fromRanges[0].start.character, 12);
+
+    // Add a new caller, and shift the existing one down a line. The calls should be re-indexed once the module is re-checked
+    result = check(R"(
+        local function foo()
+        end
+
+        local function baz()
+            foo()
+            foo()
+        end
+
+        local function bar()
+
+            foo()
+        end
+    )");
+    REQUIRE_EQ(0, result.errors.size());
+
+    calls = findIncomingCalls(*this, lsp::Position{1, 23});
+    REQUIRE_EQ(2, calls.size());
+    for (const auto& call : calls)
+    {
+        if (call.from.name == "baz")
+        {
+            REQUIRE_EQ(2, call.fromRanges.size());
+            CHECK_EQ(call.fromRanges[0].start.line, 5);
+            CHECK_EQ(call.fromRanges[1].start.line, 6);
+        }
+        else
+        {
+            CHECK_EQ(call.from.name, "bar");
+            REQUIRE_EQ(1, call.fromRanges.size());
+            CHECK_EQ(call.fromRanges[0].start.line, 11);
+            CHECK_EQ(call.fromRanges[0].start.character, 12);
+        }
+    }
+}
+
+TEST_SUITE_END();
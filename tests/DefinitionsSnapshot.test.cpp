@@ -0,0 +1,25 @@
+#include "doctest.h"
+#include "LSP/DefinitionsSnapshot.hpp"
+#include "LSP/Utils.hpp"
+
+TEST_SUITE_BEGIN("DefinitionsSnapshotTests");
+
+TEST_CASE("load_reads_every_file_and_hashes_their_contents")
+{
+    auto root = std::filesystem::temp_directory_path() / "luau-lsp-definitions-snapshot-test";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root);
+    REQUIRE(writeFileAtomically(root / "a.d.luau", "declare a: number"));
+
+    auto snapshot = DefinitionsSnapshot::load({root / "a.d.luau", root / "missing.d.luau"});
+    REQUIRE(writeFileAtomically(root / "a.d.luau", "declare a: string"));
+    auto changedSnapshot = DefinitionsSnapshot::load({root / "a.d.luau"});
+    std::filesystem::remove_all(root);
+
+    REQUIRE_EQ(snapshot.files.size(), 2);
+    CHECK_EQ(snapshot.files[0].contents, "declare a: number");
+    CHECK_FALSE(snapshot.files[1].contents);
+    CHECK_NE(snapshot.hash, changedSnapshot.hash);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,51 @@
+#include "doctest.h"
+#include "LSP/DiagnosticsCache.hpp"
+#include "LSP/Utils.hpp"
+
+TEST_SUITE_BEGIN("DiagnosticsCacheTests");
+
+TEST_CASE("cache_round_trips_through_file")
+{
+    auto path = std::filesystem::temp_directory_path() / "luau-lsp-diagnostics-cache-test.json";
+
+    json diagnostics = json::array({{{"message", "Unknown global 'foo'"}, {"severity", 1}}});
+
+    DiagnosticsCache cache;
+    cache.insert("file:///workspace/a.luau", 0xFFFFFFFFFFFFFFFFull, diagnostics);
+    CHECK(cache.isModified());
+    REQUIRE(cache.save(path));
+    CHECK_FALSE(cache.isModified());
+
+    auto loaded = DiagnosticsCache::load(path);
+    std::filesystem::remove(path);
+
+    CHECK_EQ(loaded.size(), 1);
+    CHECK_FALSE(loaded.isModified());
+
+    auto entry = loaded.find("file:///workspace/a.luau", 0xFFFFFFFFFFFFFFFFull);
+    REQUIRE(entry);
+    CHECK_EQ(*entry, diagnostics);
+}
+
+TEST_CASE("entries_with_a_different_key_are_not_returned")
+{
+    DiagnosticsCache cache;
+    cache.insert("file:///workspace/a.luau", 1, json::array());
+
+    CHECK(cache.find("file:///workspace/a.luau", 1));
+    CHECK_FALSE(cache.find("file:///workspace/a.luau", 2));
+    CHECK_FALSE(cache.find("file:///workspace/b.luau", 1));
+}
+
+TEST_CASE("malformed_cache_is_discarded")
+{
+    auto path = std::filesystem::temp_directory_path() / "luau-lsp-diagnostics-cache-test.json";
+    REQUIRE(writeFileAtomically(path, R"({"version": 1, "files": {"file:///workspace/a.luau": {"key": "not a number"}}})"));
+
+    auto loaded = DiagnosticsCache::load(path);
+    std::filesystem::remove(path);
+
+    CHECK_EQ(loaded.size(), 0);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,152 @@
+#include "doctest.h"
+#include "LSP/FileInventory.hpp"
+#include "LSP/Utils.hpp"
+
+#include <algorithm>
+
+static std::vector<std::string> sortedNames(const std::vector<FileInventory::Entry>& entries)
+{
+    std::vector<std::string> names;
+    for (const auto& entry : entries)
+        names.push_back(entry.path.filename().string());
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+static FileInventory::Classification noClassification(const std::filesystem::path&)
+{
+    return {};
+}
+
+TEST_SUITE_BEGIN("FileInventoryTests");
+
+TEST_CASE("build_finds_only_source_files")
+{
+    auto root = std::filesystem::temp_directory_path() / "luau-lsp-file-inventory-test";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "nested");
+    REQUIRE(writeFileAtomically(root / "a.luau", ""));
+    REQUIRE(writeFileAtomically(root / "nested" / "b.lua", ""));
+    REQUIRE(writeFileAtomically(root / "nested" / "c.json", ""));
+
+    FileInventory inventory(root);
+    CHECK_FALSE(inventory.isBuilt());
+    inventory.build();
+    std::filesystem::remove_all(root);
+
+    CHECK(inventory.isBuilt());
+    CHECK_EQ(sortedNames(inventory.entries("", noClassification)), std::vector<std::string>{"a.luau", "b.lua"});
+}
+
+TEST_CASE("skipped_directories_are_not_walked")
+{
+    auto root = std::filesystem::temp_directory_path() / "luau-lsp-file-inventory-test";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "Packages" / "nested");
+    std::filesystem::create_directories(root / "src");
+    REQUIRE(writeFileAtomically(root / "src" / "a.luau", ""));
+    REQUIRE(writeFileAtomically(root / "Packages" / "b.luau", ""));
+    REQUIRE(writeFileAtomically(root / "Packages" / "nested" / "c.luau", ""));
+
+    FileInventory inventory(root);
+    inventory.build(
+        [](const std::filesystem::path& directory)
+        {
+            return directory.filename() == "Packages" || directory.parent_path().filename() == "Packages";
+        });
+    inventory.add(root / "Packages" / "nested");
+    std::filesystem::remove_all(root);
+
+    CHECK_EQ(sortedNames(inventory.entries()), std::vector<std::string>{"a.luau"});
+}
+
+TEST_CASE("paths_within_skipped_directories_are_not_added")
+{
+    auto root = std::filesystem::temp_directory_path() / "luau-lsp-file-inventory-test";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "Packages" / "nested");
+    REQUIRE(writeFileAtomically(root / "Packages" / "nested" / "a.luau", ""));
+
+    FileInventory inventory(root);
+    inventory.build(
+        [](const std::filesystem::path& directory)
+        {
+            return directory.filename() == "Packages";
+        });
+    inventory.add(root / "Packages" / "nested");
+    inventory.add(root / "Packages" / "nested" / "a.luau");
+    std::filesystem::remove_all(root);
+
+    CHECK_EQ(inventory.size(), 0);
+}
+
+TEST_CASE("files_can_be_added_and_removed")
+{
+    FileInventory inventory;
+    inventory.add("/workspace/a.luau");
+    inventory.add("/workspace/b.luau");
+    inventory.add("/workspace/c.luau");
+    inventory.add("/workspace/a.luau");
+    inventory.add("/workspace/default.project.json");
+    CHECK_EQ(inventory.size(), 3);
+
+    inventory.remove("/workspace/a.luau");
+    inventory.remove("/workspace/d.luau");
+    CHECK_EQ(sortedNames(inventory.entries("", noClassification)), std::vector<std::string>{"b.luau", "c.luau"});
+
+    // The moved entry must still be removable
+    inventory.remove("/workspace/c.luau");
+    CHECK_EQ(sortedNames(inventory.entries("", noClassification)), std::vector<std::string>{"b.luau"});
+}
+
+TEST_CASE("removing_a_directory_removes_its_files")
+{
+    FileInventory inventory;
+    inventory.add("/workspace/src/a.luau");
+    inventory.add("/workspace/src/nested/b.luau");
+    inventory.add("/workspace/src2/c.luau");
+
+    inventory.remove("/workspace/src");
+    CHECK_EQ(sortedNames(inventory.entries("", noClassification)), std::vector<std::string>{"c.luau"});
+}
+
+TEST_CASE("adding_a_directory_adds_its_files")
+{
+    auto root = std::filesystem::temp_directory_path() / "luau-lsp-file-inventory-test";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "nested");
+    REQUIRE(writeFileAtomically(root / "nested" / "a.luau", ""));
+    REQUIRE(writeFileAtomically(root / "nested" / "b.json", ""));
+
+    FileInventory inventory;
+    inventory.add(root / "nested");
+    std::filesystem::remove_all(root);
+
+    CHECK_EQ(sortedNames(inventory.entries("", noClassification)), std::vector<std::string>{"a.luau"});
+}
+
+TEST_CASE("files_are_only_reclassified_when_the_key_changes")
+{
+    FileInventory inventory;
+    inventory.add("/workspace/a.luau");
+
+    size_t calls = 0;
+    auto classify = [&](const std::filesystem::path&)
+    {
+        calls++;
+        return FileInventory::Classification{false, true};
+    };
+
+    CHECK(inventory.entries("key", classify)[0].classification.ignored);
+    inventory.entries("key", classify);
+    CHECK_EQ(calls, 1);
+
+    inventory.add("/workspace/b.luau");
+    inventory.entries("key", classify);
+    CHECK_EQ(calls, 2);
+
+    inventory.entries("other", classify);
+    CHECK_EQ(calls, 4);
+}
+
+TEST_SUITE_END();
@@ -11,7 +11,7 @@
 static const char* mainModuleName = "MainModule";
 
 Fixture::Fixture()
-    : client(std::make_shared<Client>(Client{}))
+    : client(std::make_shared<Client>())
     , workspace(client, "$TEST_WORKSPACE", Uri(), std::nullopt)
 {
     workspace.fileResolver.defaultConfig.mode = Luau::Mode::Strict;
@@ -120,7 +120,12 @@ Luau::ModuleName fromString(std::string_view name)
 void Fixture::newDocument(const std::string& name, const std::string& source)
 {
     Uri uri("file", "", name);
-    workspace.openTextDocument(uri, {{uri, "luau", 0, source}});
+
+    // Replace the contents of an already open document, so that a module can be edited and checked again
+    if (auto document = workspace.fileResolver.getTextDocument(uri))
+        workspace.updateTextDocument(uri, {{{uri}, document->version() + 1}, {{std::nullopt, source}}});
+    else
+        workspace.openTextDocument(uri, {{uri, "luau", 0, source}});
 }
 
 Luau::AstStatBlock* Fixture::parse(const std::string& source, const Luau::ParseOptions& parseOptions)
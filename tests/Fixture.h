@@ -31,6 +31,7 @@ struct Fixture
     explicit Fixture();
     ~Fixture();
 
+    /// Opens the document, or replaces its contents if it is already open
     void newDocument(const std::string& name, const std::string& source);
 
     Luau::AstStatBlock* parse(const std::string& source, const Luau::ParseOptions& parseOptions = {});
@@ -0,0 +1,39 @@
+#include "doctest.h"
+#include "LSP/GlobMatcher.hpp"
+
+TEST_SUITE_BEGIN("GlobMatcherTests");
+
+TEST_CASE("matches_any_of_the_patterns")
+{
+    GlobMatcher matcher({"**/_Index/**", "*.spec.luau", "Packages/*"});
+
+    CHECK(matcher.matches("src/_Index/module.luau"));
+    CHECK(matcher.matches("src/test.spec.luau"));
+    CHECK(matcher.matches("Packages/init.luau"));
+    CHECK_FALSE(matcher.matches("src/module.luau"));
+    CHECK_FALSE(matcher.matches("src/test.spec.lua"));
+
+    // The result is memoised
+    CHECK(matcher.matches("src/test.spec.luau"));
+}
+
+TEST_CASE("no_patterns_match_nothing")
+{
+    GlobMatcher matcher({});
+    CHECK_FALSE(matcher.matches("src/module.luau"));
+    CHECK_FALSE(matcher.matchesEntireDirectory("src"));
+}
+
+TEST_CASE("directories_are_only_matched_if_all_their_contents_would_be")
+{
+    GlobMatcher matcher({"**/node_modules/**", "*.spec.luau", "Packages/*"});
+
+    CHECK(matcher.matchesEntireDirectory("project/node_modules"));
+    CHECK(matcher.matchesEntireDirectory("project/node_modules/nested"));
+    CHECK(matcher.matchesEntireDirectory("Packages/nested"));
+    CHECK(matcher.matchesEntireDirectory("Packages"));
+    CHECK_FALSE(matcher.matchesEntireDirectory("project"));
+    CHECK_FALSE(matcher.matchesEntireDirectory("src/tests.spec.luau"));
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,170 @@
+#include "doctest.h"
+#include "LSP/JsonRpc.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <future>
+
+/// Creates a reader over a fixed input, returning at most `chunkSize` bytes per read
+static json_rpc::MessageReader makeReader(const std::string& input, size_t chunkSize = SIZE_MAX, size_t initialCapacity = 16)
+{
+    auto offset = std::make_shared<size_t>(0);
+    return json_rpc::MessageReader(
+        [input, chunkSize, offset](char* buffer, size_t size) -> size_t
+        {
+            auto count = std::min({size, chunkSize, input.size() - *offset});
+            std::memcpy(buffer, input.data() + *offset, count);
+            *offset += count;
+            return count;
+        },
+        initialCapacity);
+}
+
+static std::string makeMessage(const std::string& body, const std::string& headerName = "Content-Length", const std::string& newline = "\r\n")
+{
+    return headerName + ": " + std::to_string(body.size()) + newline + newline + body;
+}
+
+TEST_SUITE_BEGIN("JsonRpcTests");
+
+TEST_CASE("reader_reads_single_message")
+{
+    auto reader = makeReader(makeMessage(R"({"jsonrpc":"2.0","method":"initialized"})"));
+
+    std::string_view output;
+    REQUIRE(reader.read(output));
+    CHECK_EQ(output, R"({"jsonrpc":"2.0","method":"initialized"})");
+    CHECK_FALSE(reader.read(output));
+}
+
+TEST_CASE("reader_reads_consecutive_messages_across_chunk_boundaries")
+{
+    std::string input;
+    for (int i = 0; i < 50; i++)
+        input += makeMessage(R"({"jsonrpc":"2.0","id":)" + std::to_string(i) + "}");
+
+    for (size_t chunkSize : {size_t(1), size_t(7), size_t(64), SIZE_MAX})
+    {
+        auto reader = makeReader(input, chunkSize);
+
+        std::string_view output;
+        for (int i = 0; i < 50; i++)
+        {
+            REQUIRE(reader.read(output));
+            CHECK_EQ(output, R"({"jsonrpc":"2.0","id":)" + std::to_string(i) + "}");
+        }
+        CHECK_FALSE(reader.read(output));
+    }
+}
+
+TEST_CASE("reader_grows_buffer_for_large_messages")
+{
+    std::string body = R"({"jsonrpc":"2.0","params":")" + std::string(100000, 'a') + "\"}";
+    auto reader = makeReader(makeMessage(body), 4096);
+
+    std::string_view output;
+    REQUIRE(reader.read(output));
+    CHECK_EQ(output, body);
+}
+
+TEST_CASE("reader_accepts_lf_line_endings_and_case_insensitive_headers")
+{
+    auto reader = makeReader(makeMessage("{}", "content-length", "\n") + "Content-Type: application/vscode-jsonrpc; charset=utf-8\r\n" +
+                             makeMessage("[]"));
+
+    std::string_view output;
+    REQUIRE(reader.read(output));
+    CHECK_EQ(output, "{}");
+    REQUIRE(reader.read(output));
+    CHECK_EQ(output, "[]");
+}
+
+TEST_CASE("reader_skips_messages_without_content_length")
+{
+    auto reader = makeReader("Content-Type: application/json\r\n\r\n" + makeMessage("{}"));
+
+    std::string_view output;
+    REQUIRE(reader.read(output));
+    CHECK_EQ(output, "{}");
+}
+
+TEST_CASE("reader_returns_false_on_truncated_message")
+{
+    auto reader = makeReader("Content-Length: 100\r\n\r\n{}");
+
+    std::string_view output;
+    CHECK_FALSE(reader.read(output));
+}
+
+TEST_CASE("parse_moves_params_out_of_message")
+{
+    auto message = json_rpc::parse(R"({"jsonrpc":"2.0","id":1,"method":"textDocument/hover","params":{"textDocument":{"uri":"file:///a.lua"}}})");
+
+    CHECK(message.is_request());
+    REQUIRE(message.params);
+    CHECK_EQ(message.params->at("textDocument").at("uri"), "file:///a.lua");
+}
+
+TEST_CASE("writer_coalesces_queued_messages_and_drops_superseded_messages")
+{
+    std::promise<void> started;
+    std::promise<void> unblock;
+    auto unblocked = unblock.get_future().share();
+    std::vector<std::string> writes;
+
+    {
+        json_rpc::MessageWriter writer(
+            [&](const char* data, size_t size)
+            {
+                // Hold up the first write, so that the following messages are all queued behind it
+                if (writes.empty())
+                    started.set_value();
+                unblocked.wait();
+                writes.emplace_back(data, size);
+                return true;
+            });
+
+        writer.write("first");
+        started.get_future().wait();
+
+        writer.write("diagnostics-a-1", "a");
+        writer.write("diagnostics-b-1", "b");
+        writer.write("response");
+        writer.write("diagnostics-a-2", "a");
+
+        unblock.set_value();
+        writer.flush();
+        CHECK_FALSE(writes.empty());
+    }
+
+    std::string output;
+    for (const auto& write : writes)
+        output += write;
+
+    CHECK_EQ(output, makeMessage("first") + makeMessage("diagnostics-b-1") + makeMessage("response") + makeMessage("diagnostics-a-2"));
+    CHECK_EQ(writes.size(), 2);
+}
+
+TEST_CASE("writer_writes_remaining_messages_on_destruction")
+{
+    std::string output;
+
+    {
+        json_rpc::MessageWriter writer(
+            [&](const char* data, size_t size)
+            {
+                output.append(data, size);
+                return true;
+            });
+
+        for (int i = 0; i < 100; i++)
+            writer.write(std::to_string(i));
+    }
+
+    std::string expected;
+    for (int i = 0; i < 100; i++)
+        expected += makeMessage(std::to_string(i));
+    CHECK_EQ(output, expected);
+}
+
+TEST_SUITE_END();
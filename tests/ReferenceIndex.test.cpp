@@ -0,0 +1,43 @@
+#include "doctest.h"
+#include "LSP/ReferenceIndex.hpp"
+
+static Luau::Location location(unsigned int line, unsigned int column)
+{
+    return Luau::Location{{line, column}, {line, column + 1}};
+}
+
+TEST_SUITE_BEGIN("ReferenceIndexTests");
+
+TEST_CASE("finds_references_to_the_property_of_the_same_table")
+{
+    ReferenceIndex index;
+    index.update("b", {
+                          PropertyReference{"a", location(0, 0), "value", location(1, 0)},
+                          PropertyReference{"a", location(0, 0), "other", location(2, 0)},
+                          PropertyReference{"a", location(5, 0), "value", location(3, 0)},
+                          PropertyReference{"c", location(0, 0), "value", location(4, 0)},
+                          PropertyReference{"a", location(0, 0), "value", location(6, 0)},
+                      });
+
+    CHECK_EQ(index.find("b", "a", location(0, 0), "value"), std::vector<Luau::Location>{location(1, 0), location(6, 0)});
+    CHECK_EQ(index.find("b", "a", location(0, 0), "missing"), std::vector<Luau::Location>{});
+    CHECK_EQ(index.find("c", "a", location(0, 0), "value"), std::vector<Luau::Location>{});
+}
+
+TEST_CASE("updating_a_module_replaces_its_references")
+{
+    ReferenceIndex index;
+    index.update("b", {PropertyReference{"a", location(0, 0), "value", location(1, 0)}});
+    index.update("c", {PropertyReference{"a", location(0, 0), "value", location(2, 0)}});
+    index.update("b", {PropertyReference{"a", location(0, 0), "other", location(3, 0)}});
+
+    CHECK(index.find("b", "a", location(0, 0), "value").empty());
+    CHECK_EQ(index.find("b", "a", location(0, 0), "other"), std::vector<Luau::Location>{location(3, 0)});
+    CHECK_EQ(index.find("c", "a", location(0, 0), "value"), std::vector<Luau::Location>{location(2, 0)});
+
+    index.remove("c");
+    CHECK_FALSE(index.contains("c"));
+    CHECK_EQ(index.size(), 1);
+}
+
+TEST_SUITE_END();
@@ -81,5 +81,31 @@ TEST_CASE_FIXTURE(Fixture, "find_table_property_declaration_4")
     CHECK(references[0].location.end.column == 23);
 }
 
+TEST_CASE_FIXTURE(Fixture, "references_are_updated_after_the_defining_module_is_edited")
+{
+    auto result = check(R"(
+        local T = {}
+        T.name = "testing"
+    )");
+    REQUIRE_EQ(0, result.errors.size());
+
+    auto references = workspace.findAllReferences(requireType("T"), "name");
+    REQUIRE_EQ(1, references.size());
+    CHECK(references[0].location.begin.line == 2);
+
+    // Shift the table down a line and add a new reference, which should be picked up when the module is re-indexed
+    result = check(R"(
+        -- a comment
+        local T = {}
+        T.name = "testing"
+        print(T.name)
+    )");
+    REQUIRE_EQ(0, result.errors.size());
+
+    references = workspace.findAllReferences(requireType("T"), "name");
+    REQUIRE_EQ(2, references.size());
+    CHECK(contains(references, Reference{"MainModule", Luau::Location{{3, 10}, {3, 14}}}));
+    CHECK(contains(references, Reference{"MainModule", Luau::Location{{4, 16}, {4, 20}}}));
+}
 
 TEST_SUITE_END();
\ No newline at end of file
@@ -0,0 +1,53 @@
+#include "doctest.h"
+#include "LSP/Replay.hpp"
+
+#include "nlohmann/json.hpp"
+
+TEST_SUITE_BEGIN("ReplayTests");
+
+TEST_CASE("recorded_session_can_be_loaded")
+{
+    auto path = std::filesystem::temp_directory_path() / "luau-lsp-replay-test.jsonl";
+
+    {
+        SessionRecorder recorder(path);
+        REQUIRE(recorder.isOpen());
+        recorder.record(R"({"jsonrpc":"2.0","id":0,"method":"initialize","params":{"rootUri":"file:///workspace"}})");
+        recorder.record(R"({"jsonrpc":"2.0","method":"initialized","params":{}})");
+    }
+
+    auto session = loadRecordedSession(path);
+    std::filesystem::remove(path);
+
+    REQUIRE_EQ(session.size(), 2);
+    CHECK_EQ(nlohmann::json::parse(session[0].message)["method"], "initialize");
+    CHECK_EQ(nlohmann::json::parse(session[0].message)["params"]["rootUri"], "file:///workspace");
+    CHECK_EQ(nlohmann::json::parse(session[1].message)["method"], "initialized");
+    CHECK_LE(session[0].time, session[1].time);
+}
+
+TEST_CASE("pretty_printed_and_invalid_messages_can_be_loaded")
+{
+    auto path = std::filesystem::temp_directory_path() / "luau-lsp-replay-test.jsonl";
+
+    {
+        SessionRecorder recorder(path);
+        REQUIRE(recorder.isOpen());
+        recorder.record("{\n    \"jsonrpc\": \"2.0\",\n    \"method\": \"initialized\",\n    \"params\": {}\n}");
+        recorder.record(R"({"jsonrpc":"2.0","method":)");
+    }
+
+    auto session = loadRecordedSession(path);
+    std::filesystem::remove(path);
+
+    REQUIRE_EQ(session.size(), 2);
+    CHECK_EQ(nlohmann::json::parse(session[0].message)["method"], "initialized");
+    CHECK_EQ(session[1].message, R"({"jsonrpc":"2.0","method":)");
+}
+
+TEST_CASE("loading_a_missing_session_throws")
+{
+    CHECK_THROWS_AS(loadRecordedSession(std::filesystem::temp_directory_path() / "luau-lsp-missing-session.jsonl"), std::runtime_error);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,77 @@
+#include "doctest.h"
+#include "LSP/RequireGraphCache.hpp"
+
+#include <fstream>
+
+TEST_SUITE_BEGIN("RequireGraphCacheTests");
+
+TEST_CASE("cache_round_trips_through_file")
+{
+    auto path = std::filesystem::temp_directory_path() / "luau-lsp-require-graph-test.json";
+
+    RequireGraphCache cache("fingerprint");
+    cache.insert("/workspace/src/a.luau", RequireGraphCache::Entry{"game/ReplicatedStorage/a", FileStamp{100, 20}, {"game/ReplicatedStorage/b"}});
+    cache.insert("/workspace/src/b.luau", RequireGraphCache::Entry{"game/ReplicatedStorage/b", FileStamp{200, 30}, {}});
+    REQUIRE(cache.save(path));
+
+    auto loaded = RequireGraphCache::load(path, "fingerprint");
+    std::filesystem::remove(path);
+
+    CHECK_EQ(loaded.size(), 2);
+
+    auto entry = loaded.find("/workspace/src/a.luau", FileStamp{100, 20});
+    REQUIRE(entry);
+    CHECK_EQ(entry->moduleName, "game/ReplicatedStorage/a");
+    CHECK_EQ(entry->requiredModules, std::vector<std::string>{"game/ReplicatedStorage/b"});
+}
+
+TEST_CASE("stale_entries_are_not_returned")
+{
+    RequireGraphCache cache("fingerprint");
+    cache.insert("/workspace/src/a.luau", RequireGraphCache::Entry{"a", FileStamp{100, 20}, {}});
+
+    CHECK(cache.find("/workspace/src/a.luau", FileStamp{100, 20}));
+    CHECK_FALSE(cache.find("/workspace/src/a.luau", FileStamp{101, 20}));
+    CHECK_FALSE(cache.find("/workspace/src/a.luau", FileStamp{100, 21}));
+    CHECK_FALSE(cache.find("/workspace/src/other.luau", FileStamp{100, 20}));
+}
+
+TEST_CASE("cache_with_different_fingerprint_is_discarded")
+{
+    auto path = std::filesystem::temp_directory_path() / "luau-lsp-require-graph-test.json";
+
+    RequireGraphCache cache("old sourcemap");
+    cache.insert("/workspace/src/a.luau", RequireGraphCache::Entry{"a", FileStamp{100, 20}, {}});
+    REQUIRE(cache.save(path));
+
+    auto loaded = RequireGraphCache::load(path, "new sourcemap");
+    std::filesystem::remove(path);
+
+    CHECK_EQ(loaded.size(), 0);
+}
+
+TEST_CASE("malformed_cache_is_discarded")
+{
+    auto path = std::filesystem::temp_directory_path() / "luau-lsp-require-graph-test.json";
+    {
+        std::ofstream output(path);
+        output << R"({"version": 1, "fingerprint": "fingerprint", "files": {"/workspace/src/a.luau": {"module": "a"}})";
+    }
+
+    auto loaded = RequireGraphCache::load(path, "fingerprint");
+    std::filesystem::remove(path);
+
+    CHECK_EQ(loaded.size(), 0);
+}
+
+TEST_CASE("workspace_cache_paths_are_distinct")
+{
+    auto first = RequireGraphCache::pathForWorkspace("/cache", "file:///workspace/a");
+    auto second = RequireGraphCache::pathForWorkspace("/cache", "file:///workspace/b");
+
+    CHECK_NE(first, second);
+    CHECK_EQ(first.parent_path(), std::filesystem::path("/cache"));
+    CHECK_EQ(first, RequireGraphCache::pathForWorkspace("/cache", "file:///workspace/a"));
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,54 @@
+#include "doctest.h"
+#include "LSP/ReverseDependencyIndex.hpp"
+
+#include <algorithm>
+
+static std::vector<std::string> sorted(std::vector<std::string> modules)
+{
+    std::sort(modules.begin(), modules.end());
+    return modules;
+}
+
+TEST_SUITE_BEGIN("ReverseDependencyIndexTests");
+
+TEST_CASE("finds_transitive_dependents")
+{
+    ReverseDependencyIndex index;
+    index.update("a", {});
+    index.update("b", {"a"});
+    index.update("c", {"b"});
+    index.update("d", {"a", "c"});
+    index.update("e", {});
+
+    auto dependents = index.findTransitiveDependents("a");
+    CHECK_EQ(dependents.front(), "a");
+    CHECK_EQ(sorted(dependents), std::vector<std::string>{"a", "b", "c", "d"});
+    CHECK_EQ(index.findTransitiveDependents("e"), std::vector<std::string>{"e"});
+}
+
+TEST_CASE("cycles_are_only_visited_once")
+{
+    ReverseDependencyIndex index;
+    index.update("a", {"b"});
+    index.update("b", {"a"});
+
+    CHECK_EQ(sorted(index.findTransitiveDependents("a")), std::vector<std::string>{"a", "b"});
+}
+
+TEST_CASE("updating_a_module_replaces_its_requires")
+{
+    ReverseDependencyIndex index;
+    index.update("b", {"a"});
+    index.update("c", {"a"});
+
+    index.update("b", {"c"});
+    CHECK_EQ(sorted(index.findTransitiveDependents("a")), std::vector<std::string>{"a", "b", "c"});
+    CHECK_EQ(sorted(index.findTransitiveDependents("c")), std::vector<std::string>{"b", "c"});
+
+    index.remove("c");
+    CHECK_FALSE(index.contains("c"));
+    CHECK_EQ(index.findTransitiveDependents("a"), std::vector<std::string>{"a"});
+    CHECK_EQ(sorted(index.findTransitiveDependents("c")), std::vector<std::string>{"b", "c"});
+}
+
+TEST_SUITE_END();
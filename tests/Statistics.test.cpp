@@ -0,0 +1,64 @@
+#include "doctest.h"
+#include "LSP/Statistics.hpp"
+
+using namespace std::chrono_literals;
+
+TEST_SUITE_BEGIN("StatisticsTests");
+
+TEST_CASE("histogram_reports_count_max_and_total")
+{
+    LatencyHistogram histogram;
+    histogram.record(1ms);
+    histogram.record(2ms);
+    histogram.record(7ms);
+
+    CHECK_EQ(histogram.count(), 3);
+    CHECK_EQ(histogram.maxMs(), 7.0);
+    CHECK_EQ(histogram.totalMs(), 10.0);
+}
+
+TEST_CASE("histogram_percentiles_are_within_bucket_precision")
+{
+    LatencyHistogram histogram;
+    for (int i = 1; i <= 1000; i++)
+        histogram.record(std::chrono::milliseconds(i));
+
+    // Buckets are accurate to within 12.5%
+    CHECK(histogram.percentileMs(0.50) >= 500.0);
+    CHECK(histogram.percentileMs(0.50) <= 500.0 * 1.125);
+    CHECK(histogram.percentileMs(0.95) >= 950.0);
+    CHECK(histogram.percentileMs(0.95) <= 1000.0);
+    CHECK(histogram.percentileMs(0.99) >= 990.0);
+    CHECK(histogram.percentileMs(0.99) <= 1000.0);
+}
+
+TEST_CASE("histogram_handles_small_and_empty_values")
+{
+    LatencyHistogram histogram;
+    CHECK_EQ(histogram.percentileMs(0.5), 0.0);
+
+    histogram.record(0us);
+    histogram.record(3us);
+    CHECK_EQ(histogram.percentileMs(1.0), 0.003);
+}
+
+TEST_CASE("statistics_groups_histograms_by_category_and_name")
+{
+    Statistics statistics;
+    statistics.record(Statistics::Requests, "textDocument/hover", 5ms);
+    statistics.record(Statistics::Requests, "textDocument/hover", 10ms);
+    statistics.record(Statistics::Frontend, "check", 3ms);
+
+    auto result = statistics.toJson();
+    CHECK_EQ(result["requests"]["textDocument/hover"]["count"], 2);
+    CHECK_EQ(result["requests"]["textDocument/hover"]["max"], 10.0);
+    CHECK_EQ(result["frontend"]["check"]["count"], 1);
+    CHECK_FALSE(result.contains("notifications"));
+
+    CHECK_NE(statistics.toString().find("textDocument/hover"), std::string::npos);
+
+    statistics.clear();
+    CHECK_FALSE(statistics.toJson().contains("requests"));
+}
+
+TEST_SUITE_END();
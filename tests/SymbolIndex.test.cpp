@@ -0,0 +1,70 @@
+#include "doctest.h"
+#include "LSP/SymbolIndex.hpp"
+
+static lsp::WorkspaceSymbol makeSymbol(const std::string& name)
+{
+    lsp::WorkspaceSymbol symbol;
+    symbol.name = name;
+    symbol.kind = lsp::SymbolKind::Function;
+    return symbol;
+}
+
+static std::vector<std::string> names(const std::vector<lsp::WorkspaceSymbol>& symbols)
+{
+    std::vector<std::string> result;
+    for (const auto& symbol : symbols)
+        result.push_back(symbol.name);
+    return result;
+}
+
+TEST_SUITE_BEGIN("SymbolIndexTests");
+
+TEST_CASE("humps_splits_camel_case_and_snake_case")
+{
+    CHECK_EQ(SymbolIndex::humps("getPlayerData"), "gpd");
+    CHECK_EQ(SymbolIndex::humps("get_player_data"), "gpd");
+    CHECK_EQ(SymbolIndex::humps("HTTPService"), "h");
+    CHECK_EQ(SymbolIndex::humps("Vector3"), "v3");
+    CHECK_EQ(SymbolIndex::humps("Module.doThing"), "mdt");
+}
+
+TEST_CASE("matches_are_ranked")
+{
+    SymbolIndex index;
+    index.update("a", {makeSymbol("playerData"), makeSymbol("getPlayerData"), makeSymbol("player")});
+    index.update("b", {makeSymbol("Player"), makeSymbol("gamePassInfo"), makeSymbol("unrelated")});
+
+    CHECK_EQ(names(index.search("player", 10)), std::vector<std::string>{"Player", "player", "playerData", "getPlayerData"});
+    CHECK_EQ(names(index.search("gpd", 10)), std::vector<std::string>{"getPlayerData"});
+    CHECK_EQ(names(index.search("gp", 10)), std::vector<std::string>{"gamePassInfo", "getPlayerData"});
+    CHECK_EQ(names(index.search("data", 10)), std::vector<std::string>{"playerData", "getPlayerData"});
+    CHECK_EQ(index.search("", 10).size(), 6);
+    CHECK(index.search("missing", 10).empty());
+}
+
+TEST_CASE("results_are_limited_to_the_best_matches")
+{
+    SymbolIndex index;
+    index.update("a", {makeSymbol("valueLonger"), makeSymbol("value"), makeSymbol("valueLong")});
+
+    CHECK_EQ(names(index.search("value", 2)), std::vector<std::string>{"value", "valueLong"});
+}
+
+TEST_CASE("updating_a_module_replaces_its_symbols")
+{
+    SymbolIndex index;
+    index.update("a", {makeSymbol("oldName")});
+    index.update("b", {makeSymbol("otherName")});
+    CHECK_EQ(index.size(), 2);
+
+    index.update("a", {makeSymbol("newName")});
+    CHECK_EQ(index.size(), 2);
+    CHECK(index.search("oldName", 10).empty());
+    CHECK_EQ(names(index.search("newName", 10)), std::vector<std::string>{"newName"});
+
+    index.remove("b");
+    CHECK_EQ(index.size(), 1);
+    CHECK_EQ(names(index.search("name", 10)), std::vector<std::string>{"newName"});
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,134 @@
+#include "doctest.h"
+#include "LSP/WorkerPool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <string>
+
+TEST_SUITE_BEGIN("WorkerPoolTests");
+
+TEST_CASE("tasks_are_executed_in_priority_order")
+{
+    std::vector<std::string> order;
+
+    {
+        WorkerPool pool(1);
+
+        // Hold up the only worker, so that all the following tasks are queued up behind it
+        std::promise<void> started;
+        std::promise<void> unblock;
+        auto unblocked = unblock.get_future().share();
+        pool.push(
+            [&]
+            {
+                started.set_value();
+                unblocked.wait();
+            });
+        started.get_future().wait();
+
+        pool.push(
+            [&]
+            {
+                order.emplace_back("background1");
+            },
+            TaskPriority::Background);
+        pool.push(
+            [&]
+            {
+                order.emplace_back("normal");
+            });
+        pool.push(
+            [&]
+            {
+                order.emplace_back("background2");
+            },
+            TaskPriority::Background);
+        pool.push(
+            [&]
+            {
+                order.emplace_back("interactive");
+            },
+            TaskPriority::Interactive);
+
+        unblock.set_value();
+
+        // Wait for the queue to drain. A task pushed at the lowest priority will be executed last
+        std::promise<void> finished;
+        pool.push(
+            [&]
+            {
+                finished.set_value();
+            },
+            TaskPriority::Background);
+        finished.get_future().wait();
+    }
+
+    CHECK_EQ(order, std::vector<std::string>{"interactive", "normal", "background1", "background2"});
+}
+
+TEST_CASE("remaining_tasks_are_drained_on_destruction")
+{
+    std::atomic<int> count = 0;
+
+    {
+        WorkerPool pool(2);
+        for (int i = 0; i < 100; i++)
+            pool.push(
+                [&]
+                {
+                    count++;
+                });
+    }
+
+    CHECK_EQ(count, 100);
+}
+
+TEST_CASE("delayed_tasks_are_executed_in_due_order")
+{
+    std::vector<std::string> order;
+
+    {
+        WorkerPool pool(1);
+
+        std::promise<void> finished;
+        pool.pushAfter(std::chrono::milliseconds(20),
+            [&]
+            {
+                order.emplace_back("later");
+                finished.set_value();
+            });
+        pool.pushAfter(std::chrono::milliseconds(5),
+            [&]
+            {
+                order.emplace_back("sooner");
+            });
+        pool.push(
+            [&]
+            {
+                order.emplace_back("immediate");
+            });
+
+        finished.get_future().wait();
+    }
+
+    CHECK_EQ(order, std::vector<std::string>{"immediate", "sooner", "later"});
+}
+
+TEST_CASE("delayed_tasks_not_yet_due_are_abandoned_on_destruction")
+{
+    std::atomic<bool> executed = false;
+
+    {
+        WorkerPool pool(1);
+        pool.pushAfter(std::chrono::hours(1),
+            [&]
+            {
+                executed = true;
+            });
+    }
+
+    CHECK_FALSE(executed);
+}
+
+TEST_SUITE_END();
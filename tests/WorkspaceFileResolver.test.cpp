@@ -104,4 +104,16 @@ TEST_CASE_FIXTURE(Fixture, "resolveDirectoryAliases")
     CHECK_EQ(resolveDirectoryAlias(directoryAliases, "@test3/bar"), std::nullopt);
 }
 
+TEST_CASE("canonicalPath resolves relative components and is memoised")
+{
+    WorkspaceFileResolver fileResolver;
+
+    auto root = std::filesystem::weakly_canonical(std::filesystem::temp_directory_path());
+    CHECK_EQ(fileResolver.canonicalPath(root / "nested" / ".." / "file.luau"), root / "file.luau");
+    CHECK_EQ(fileResolver.canonicalPaths.size(), 1);
+
+    CHECK_EQ(fileResolver.canonicalPath(root / "nested" / ".." / "file.luau"), root / "file.luau");
+    CHECK_EQ(fileResolver.canonicalPaths.size(), 1);
+}
+
 TEST_SUITE_END();
\ No newline at end of file